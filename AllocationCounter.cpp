@@ -0,0 +1,81 @@
+#include "AllocationCounter.h"
+
+#ifdef COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Kept in its own translation unit so no caller sees (and inlines) the
+// replacements; only diagnostic builds pay the increment per allocation
+static std::atomic<unsigned long long> heapAllocations(0);
+
+// =========================================
+// REPLACED GLOBAL ALLOCATION FUNCTIONS
+// =========================================
+
+/**
+ * Global operator new - counts the call, then allocates with malloc
+ * @param size: Bytes requested
+ * @return: The allocated block
+ */
+void *operator new(std::size_t size)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void *block = std::malloc(size == 0 ? 1 : size);
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+/**
+ * Global operator delete matching the replaced operator new
+ * @param block: Block returned by operator new (or nullptr)
+ */
+void operator delete(void *block) noexcept
+{
+    std::free(block);
+}
+
+/**
+ * Sized global operator delete matching the replaced operator new
+ * @param block: Block returned by operator new (or nullptr)
+ */
+void operator delete(void *block, std::size_t) noexcept
+{
+    std::free(block);
+}
+
+#endif
+
+// =========================================
+// COUNTER
+// =========================================
+
+/**
+ * Tells whether this build counts heap allocations
+ * @return: True if compiled with COUNT_ALLOCATIONS
+ */
+bool isHeapAllocationCountAvailable()
+{
+#ifdef COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Returns the number of global operator new calls so far (all threads)
+ * @return: Allocation count (0 when counting isn't compiled in)
+ */
+unsigned long long getHeapAllocationCount()
+{
+#ifdef COUNT_ALLOCATIONS
+    return heapAllocations.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,27 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+/**
+ * Heap allocation counting (diagnostic builds only)
+ * When AllocationCounter.cpp is compiled with -DCOUNT_ALLOCATIONS it replaces the
+ * global operator new / operator delete with versions that count every allocation,
+ * so a benchmark can read the counter before and after a piece of code and see
+ * how many allocations it made. Without the define the program keeps the
+ * library's allocator untouched and the counter reports itself unavailable.
+ * The array and nothrow forms forward to the replaced operator new; over-aligned
+ * allocations keep the library's own allocator and are not counted
+ */
+
+/**
+ * Tells whether this build counts heap allocations
+ * @return: True if AllocationCounter.cpp was compiled with COUNT_ALLOCATIONS
+ */
+bool isHeapAllocationCountAvailable();
+
+/**
+ * Gets the number of global operator new calls so far (all threads)
+ * @return: Allocation count (always 0 unless isHeapAllocationCountAvailable())
+ */
+unsigned long long getHeapAllocationCount();
+
+#endif
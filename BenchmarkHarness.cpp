@@ -0,0 +1,283 @@
+#include "BenchmarkHarness.h"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <random>
+
+// =========================================
+// CONSTRUCTOR & CALIBRATION
+// =========================================
+
+/**
+ * Constructor - calibrates the timer overhead once for all measurements
+ * @param config: Run parameters
+ */
+BenchmarkHarness::BenchmarkHarness(const BenchmarkConfig &config)
+    : config(config), timerOverhead(calibrateTimerOverhead()), sink(0)
+{
+}
+
+/**
+ * Measures back-to-back clock reads many times
+ * The median is used rather than the minimum so that the correction is not
+ * larger than what a typical sample actually paid
+ * @return: Median cost of two clock reads in nanoseconds
+ */
+double BenchmarkHarness::calibrateTimerOverhead()
+{
+    const int ROUNDS = 10001;
+    std::vector<double> costs(ROUNDS);
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto end = std::chrono::steady_clock::now();
+        costs[i] = std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    std::nth_element(costs.begin(), costs.begin() + ROUNDS / 2, costs.end());
+    return costs[ROUNDS / 2];
+}
+
+// =========================================
+// WORKLOADS
+// =========================================
+
+/**
+ * Draws a workload of keys from the whole dictionary
+ * 1. Pick records: uniformly, or by Zipfian rank over a seeded shuffle of the records
+ *    (inverse CDF over the precomputed cumulative weights)
+ * 2. For misses, change one letter of the picked word until the Trie no longer has it
+ *    (the Trie is case-insensitive, so the key is absent from every structure)
+ * @param store: WordStore to draw words from
+ * @param trie: Trie used to check that misses are absent
+ * @param distribution: Uniform or Zipfian
+ * @param hits: True for present words, false for absent ones
+ * @return: keysPerWorkload keys
+ */
+std::vector<std::string> BenchmarkHarness::makeWorkload(const WordStore &store, const Trie &trie,
+                                                        KeyDistribution distribution, bool hits) const
+{
+    std::vector<std::string> keys;
+    int recordCount = store.size();
+    if (recordCount == 0)
+    {
+        return keys;
+    }
+
+    std::mt19937 random(config.seed + (distribution == KeyDistribution::ZIPFIAN ? 1 : 0) + (hits ? 0 : 2));
+
+    // Popularity rank -> record ID, and the Zipfian cumulative weights
+    std::vector<WordId> byRank(recordCount);
+    std::iota(byRank.begin(), byRank.end(), 0);
+    std::vector<double> cumulative;
+    if (distribution == KeyDistribution::ZIPFIAN)
+    {
+        std::shuffle(byRank.begin(), byRank.end(), std::mt19937(config.seed));
+        cumulative.resize(recordCount);
+        double total = 0;
+        for (int rank = 0; rank < recordCount; rank++)
+        {
+            total += 1.0 / std::pow(rank + 1.0, config.zipfExponent);
+            cumulative[rank] = total;
+        }
+    }
+
+    std::uniform_int_distribution<int> uniformRecord(0, recordCount - 1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    while (static_cast<int>(keys.size()) < config.keysPerWorkload)
+    {
+        WordId id;
+        if (distribution == KeyDistribution::ZIPFIAN)
+        {
+            double target = unit(random) * cumulative.back();
+            size_t rank = std::lower_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin();
+            id = byRank[std::min(rank, cumulative.size() - 1)];
+        }
+        else
+        {
+            id = static_cast<WordId>(uniformRecord(random));
+        }
+
+        std::string key(store.get(id).getWord());
+        if (key.empty())
+        {
+            continue;
+        }
+
+        if (!hits)
+        {
+            // Replace one letter until the word is absent (a few tries are almost always enough)
+            std::uniform_int_distribution<size_t> position(0, key.size() - 1);
+            std::uniform_int_distribution<int> letter('a', 'z');
+            std::string original = key;
+            for (int attempt = 0; attempt < 8 && trie.search(key) != nullptr; attempt++)
+            {
+                key = original;
+                key[position(random)] = static_cast<char>(letter(random));
+            }
+            if (trie.search(key) != nullptr)
+            {
+                continue;
+            }
+        }
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+// =========================================
+// STATISTICS
+// =========================================
+
+/**
+ * Linear-interpolated quantile of sorted samples
+ * @param sorted: Samples in ascending order (not empty)
+ * @param fraction: Quantile in [0, 1]
+ * @return: Interpolated value
+ */
+static double quantile(const std::vector<double> &sorted, double fraction)
+{
+    double position = fraction * (sorted.size() - 1);
+    size_t below = static_cast<size_t>(position);
+    size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (sorted[above] - sorted[below]) * (position - below);
+}
+
+/**
+ * Computes the summary statistics of a set of samples
+ * Mean CI: mean +/- 1.96 standard errors. Median CI: the sorted samples at ranks
+ * n/2 -/+ 1.96 * sqrt(n)/2, which holds whatever the distribution (timings are skewed)
+ * @param samples: Per-lookup times (nanoseconds); must not be empty
+ * @return: Summary statistics
+ */
+BenchmarkStats BenchmarkHarness::summarize(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+
+    BenchmarkStats stats;
+    stats.samples = n;
+    stats.min = samples.front();
+    stats.median = quantile(samples, 0.5);
+    stats.p99 = quantile(samples, 0.99);
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+
+    double squares = 0;
+    for (double sample : samples)
+    {
+        squares += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = (n > 1) ? std::sqrt(squares / (n - 1)) : 0.0;
+
+    double halfWidth = 1.96 * stats.stddev / std::sqrt(static_cast<double>(n));
+    stats.meanLow = stats.mean - halfWidth;
+    stats.meanHigh = stats.mean + halfWidth;
+
+    double rankSpread = 1.96 * std::sqrt(static_cast<double>(n)) / 2.0;
+    double lowRank = std::floor(n / 2.0 - rankSpread);
+    double highRank = std::ceil(n / 2.0 + rankSpread);
+    stats.medianLow = samples[static_cast<size_t>(std::max(0.0, lowRank))];
+    stats.medianHigh = samples[std::min(n - 1, static_cast<size_t>(std::max(0.0, highRank)))];
+    return stats;
+}
+
+// =========================================
+// REPORTING
+// =========================================
+
+/**
+ * Quotes a string for JSON
+ * @param text: Text to quote
+ * @return: Text in double quotes with '"' and '\' escaped
+ */
+static std::string jsonString(const std::string &text)
+{
+    std::string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+/**
+ * Writes the configuration, timer overhead and every result as JSON
+ * Times are nanoseconds per lookup with two decimals; the layout is one result
+ * per line so that two runs can be compared with a plain diff
+ * @param filename: Destination path (replaced)
+ * @return: True on success
+ */
+bool BenchmarkHarness::writeJson(const std::string &filename) const
+{
+    std::ofstream out(filename);
+    if (!out)
+    {
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(2);
+    out << "{\n";
+    out << "  \"config\": {\"keysPerWorkload\": " << config.keysPerWorkload
+        << ", \"samples\": " << config.samples
+        << ", \"warmupRounds\": " << config.warmupRounds
+        << ", \"zipfExponent\": " << config.zipfExponent
+        << ", \"seed\": " << config.seed << "},\n";
+    out << "  \"timerOverheadNs\": " << timerOverhead << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchmarkResult &result = results[i];
+        const BenchmarkStats &stats = result.stats;
+        out << "    {\"structure\": " << jsonString(result.structure)
+            << ", \"workload\": " << jsonString(result.workload)
+            << ", \"hitRate\": " << result.hitRate
+            << ", \"samples\": " << stats.samples
+            << ", \"minNs\": " << stats.min
+            << ", \"medianNs\": " << stats.median
+            << ", \"p99Ns\": " << stats.p99
+            << ", \"meanNs\": " << stats.mean
+            << ", \"stddevNs\": " << stats.stddev
+            << ", \"meanCi95Ns\": [" << stats.meanLow << ", " << stats.meanHigh << "]"
+            << ", \"medianCi95Ns\": [" << stats.medianLow << ", " << stats.medianHigh << "]}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+// =========================================
+// GETTERS
+// =========================================
+
+/**
+ * Gets every recorded result, in measurement order
+ * @return: Results
+ */
+const std::vector<BenchmarkResult> &BenchmarkHarness::getResults() const
+{
+    return results;
+}
+
+/**
+ * Gets the calibrated cost of a pair of clock reads
+ * @return: Overhead in nanoseconds
+ */
+double BenchmarkHarness::getTimerOverhead() const
+{
+    return timerOverhead;
+}
+
+/**
+ * Gets the run parameters
+ * @return: Configuration
+ */
+const BenchmarkConfig &BenchmarkHarness::getConfig() const
+{
+    return config;
+}
@@ -0,0 +1,198 @@
+#ifndef BENCHMARKHARNESS_H
+#define BENCHMARKHARNESS_H
+
+#include "WordStore.h"
+#include "Trie.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * KeyDistribution - How workload keys are drawn from the dictionary
+ */
+enum class KeyDistribution
+{
+    UNIFORM, // Every word equally likely
+    ZIPFIAN  // Word of popularity rank r drawn with probability proportional to 1 / r^s
+};
+
+/**
+ * BenchmarkConfig - Parameters of a BenchmarkHarness run
+ */
+struct BenchmarkConfig
+{
+    int keysPerWorkload = 1000; // Keys per workload (one timed sample looks up all of them)
+    int samples = 1000;         // Timed samples per structure and workload (= iterations per key)
+    int warmupRounds = 5;       // Untimed passes over the workload before sampling
+    double zipfExponent = 0.99; // s of the Zipfian distribution
+    uint32_t seed = 20251;      // Seed for workload generation (same seed = same keys)
+};
+
+/**
+ * BenchmarkStats - Summary of the per-lookup times of one measurement (nanoseconds)
+ * Confidence intervals are 95%: normal approximation for the mean,
+ * distribution-free order statistics for the median
+ */
+struct BenchmarkStats
+{
+    size_t samples;    // Number of timed samples
+    double min;        // Fastest sample
+    double median;     // Median sample
+    double p99;        // 99th percentile sample
+    double mean;       // Mean of the samples
+    double stddev;     // Sample standard deviation
+    double meanLow;    // 95% confidence interval of the mean (low end)
+    double meanHigh;   // 95% confidence interval of the mean (high end)
+    double medianLow;  // 95% confidence interval of the median (low end)
+    double medianHigh; // 95% confidence interval of the median (high end)
+};
+
+/**
+ * BenchmarkResult - One structure measured on one workload
+ */
+struct BenchmarkResult
+{
+    std::string structure; // Structure name (e.g. "Tree")
+    std::string workload;  // Workload name (e.g. "zipf-miss")
+    double hitRate;        // Fraction of workload keys found
+    BenchmarkStats stats;  // Per-lookup time statistics
+};
+
+/**
+ * BenchmarkHarness - Repeatable lookup micro-benchmarks
+ * Timing a single lookup measures the clock more than the lookup, so each sample
+ * times a whole workload (keysPerWorkload lookups) and divides by its size after
+ * subtracting the calibrated cost of reading the clock. Every structure gets the
+ * same keys, the same warmup and the same number of samples, and results carry
+ * confidence intervals so that differences within the noise are visible as such
+ * Results can be written as JSON to diff runs
+ */
+class BenchmarkHarness
+{
+private:
+    BenchmarkConfig config;               // Run parameters
+    double timerOverhead;                 // Cost of one pair of clock reads (nanoseconds)
+    std::vector<BenchmarkResult> results; // Measurements so far, in order
+    volatile uintptr_t sink;              // Keeps lookup results alive so they aren't optimized away
+
+    /**
+     * Measures the cost of reading the clock twice back to back
+     * @return: Median cost in nanoseconds
+     */
+    static double calibrateTimerOverhead();
+
+public:
+    // === CONSTRUCTOR ===
+
+    /**
+     * Constructor - calibrates the timer overhead
+     * @param config: Run parameters
+     */
+    explicit BenchmarkHarness(const BenchmarkConfig &config = BenchmarkConfig());
+
+    // === WORKLOADS ===
+
+    /**
+     * Draws a workload of keys from the whole dictionary
+     * Zipfian popularity ranks are a fixed shuffle of the records, so popular
+     * words are spread over the alphabet. Misses are dictionary words with one
+     * letter changed (checked absent), so they share long prefixes with real words
+     * @param store: WordStore to draw words from
+     * @param trie: Trie used to check that misses are absent
+     * @param distribution: Uniform or Zipfian
+     * @param hits: True for present words, false for absent ones
+     * @return: keysPerWorkload keys
+     */
+    std::vector<std::string> makeWorkload(const WordStore &store, const Trie &trie,
+                                          KeyDistribution distribution, bool hits) const;
+
+    // === MEASUREMENT ===
+
+    /**
+     * Measures a lookup function on a workload and records the result
+     * Runs the warmup passes, then times `samples` passes over the keys
+     * @param structure: Structure name for the report
+     * @param workload: Workload name for the report
+     * @param keys: Workload from makeWorkload()
+     * @param lookup: Callable taking a const std::string & and returning const Word *
+     * @return: The recorded result
+     */
+    template <typename Lookup>
+    const BenchmarkResult &measure(const std::string &structure, const std::string &workload,
+                                   const std::vector<std::string> &keys, Lookup lookup)
+    {
+        uintptr_t accumulated = 0;
+        for (int round = 0; round < config.warmupRounds; round++)
+        {
+            for (const std::string &key : keys)
+            {
+                accumulated ^= reinterpret_cast<uintptr_t>(lookup(key));
+            }
+        }
+
+        size_t found = 0;
+        for (const std::string &key : keys)
+        {
+            found += (lookup(key) != nullptr) ? 1 : 0;
+        }
+
+        std::vector<double> perLookup(config.samples);
+        for (int sample = 0; sample < config.samples; sample++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (const std::string &key : keys)
+            {
+                accumulated ^= reinterpret_cast<uintptr_t>(lookup(key));
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            double elapsed = std::chrono::duration<double, std::nano>(end - start).count() - timerOverhead;
+            perLookup[sample] = std::max(0.0, elapsed) / static_cast<double>(keys.size());
+        }
+        sink = accumulated;
+
+        double hitRate = keys.empty() ? 0.0 : static_cast<double>(found) / keys.size();
+        results.push_back(BenchmarkResult{structure, workload, hitRate, summarize(perLookup)});
+        return results.back();
+    }
+
+    /**
+     * Computes the summary statistics of a set of samples
+     * @param samples: Per-lookup times (nanoseconds); must not be empty
+     * @return: Min, median, p99, mean, standard deviation and confidence intervals
+     */
+    static BenchmarkStats summarize(std::vector<double> samples);
+
+    // === REPORTING ===
+
+    /**
+     * Writes the configuration, timer overhead and every result as JSON
+     * @param filename: Destination path (replaced)
+     * @return: True on success
+     */
+    bool writeJson(const std::string &filename) const;
+
+    // === GETTERS ===
+
+    /**
+     * Gets every recorded result, in measurement order
+     * @return: Results
+     */
+    const std::vector<BenchmarkResult> &getResults() const;
+
+    /**
+     * Gets the calibrated cost of a pair of clock reads
+     * @return: Overhead in nanoseconds
+     */
+    double getTimerOverhead() const;
+
+    /**
+     * Gets the run parameters
+     * @return: Configuration
+     */
+    const BenchmarkConfig &getConfig() const;
+};
+
+#endif
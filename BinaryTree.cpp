@@ -1,15 +1,17 @@
 #include "BinaryTree.h"
 
+#include <algorithm>
+
 // =========================================
 // TREENODE IMPLEMENTATION
 // =========================================
 
 /**
  * TreeNode Constructor
- * Initializes a new tree node with the given word
- * @param wd: Word object to store in this node
+ * Initializes a new leaf node referencing the given record
+ * @param id: Record ID of the word stored in this node
  */
-TreeNode::TreeNode(const Word &wd) : word(wd), left(nullptr), right(nullptr) {}
+TreeNode::TreeNode(WordId id) : wordId(id), height(1), left(NULL_NODE), right(NULL_NODE) {}
 
 // =========================================
 // BINARYTREE IMPLEMENTATION
@@ -18,77 +20,478 @@ TreeNode::TreeNode(const Word &wd) : word(wd), left(nullptr), right(nullptr) {}
 /**
  * BinaryTree Constructor
  * Creates an empty BST with no root node
+ * Nodes come from the tree's own arena and are released together with it,
+ * so there is no per-node teardown
+ * @param store: Record store holding the words (must outlive the tree)
+ * @param mode: Balancing strategy (UNBALANCED or AVL)
+ * @param hugePages: Back the node arena with huge pages where supported
  */
-BinaryTree::BinaryTree() : root(nullptr), nodeCount(0) {}
+BinaryTree::BinaryTree(const WordStore &store, TreeMode mode, bool hugePages)
+    : store(&store), nodes(hugePages), root(NULL_NODE), nodeCount(0), mode(mode), epochs(nullptr) {}
 
 /**
- * BinaryTree Destructor
- * Destroys the entire tree starting from root
+ * Returns the word text a node is keyed by
+ * @param node: Node to read
+ * @return: View of the word text in the WordStore
  */
-BinaryTree::~BinaryTree()
+std::string_view BinaryTree::keyOf(NodeIndex node) const
 {
-    destroyTree(root);
+    return store->get(nodes.get(node).wordId).getWord();
 }
 
+// =========================================
+// INSERTION OPERATION
+// =========================================
+
 /**
- * Recursively destroys all nodes in the BST
- * Post-order traversal: destroys children first, then parent
- * @param node: Current node to destroy
+ * Inserts a word into the BST
+ * Maintains BST property: left < parent < right (alphabetically)
+ * Time Complexity: O(log n) average, O(n) worst case (O(log n) worst case in AVL mode)
+ * @param id: Record ID of the word in the WordStore
  */
-void BinaryTree::destroyTree(TreeNode *node)
+void BinaryTree::insert(WordId id)
 {
-    if (node != nullptr)
+    if (epochs != nullptr)
     {
-        destroyTree(node->left);  // Destroy left subtree
-        destroyTree(node->right); // Destroy right subtree
-        delete node;              // Delete current node
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (insertConcurrent(id))
+        {
+            nodeCount++;
+        }
+        return;
+    }
+
+    // Duplicates are ignored, so only count nodes that were actually created
+    if (insertHelper(id))
+    {
+        nodeCount++;
     }
 }
 
+/**
+ * Iterative helper function to insert a word into the BST
+ * 1. Walk down from the root, remembering each link (parent pointer slot) on the path
+ * 2. Attach a new node at the empty link that was reached
+ * 3. Walk back up the path refreshing heights and (in AVL mode) rebalancing;
+ *    stop as soon as a subtree's height is unchanged since nothing above can change
+ * The path lives in a reused heap vector, so stack usage is constant even for degenerate trees
+ * @param id: Record ID of the word to insert
+ * @return: True if a new node was created, false if the word is a duplicate
+ */
+bool BinaryTree::insertHelper(WordId id)
+{
+    std::string_view name = store->get(id).getWord();
+    insertPath.clear();
+    NodeIndex top = root;
+    NodeIndex *link = &top;
+
+    // Navigate left or right based on alphabetical comparison
+    while (*link != NULL_NODE)
+    {
+        NodeIndex node = *link;
+        insertPath.push_back(link);
+
+        int cmp = name.compare(keyOf(node));
+        if (cmp < 0)
+        {
+            // Word comes alphabetically before current node -> go left
+            link = &nodes.get(node).left;
+        }
+        else if (cmp > 0)
+        {
+            // Word comes alphabetically after current node -> go right
+            link = &nodes.get(node).right;
+        }
+        else
+        {
+            // Same word text as the current node: duplicate - don't insert again
+            return false;
+        }
+    }
+
+    // Found the insertion point (empty spot); links point into the arena, which never moves
+    NodeIndex created = nodes.create(cursor, id);
+    *link = created;
+
+    // Fix heights (and balance) bottom-up along the recorded path
+    for (auto it = insertPath.rbegin(); it != insertPath.rend(); ++it)
+    {
+        NodeIndex *pathLink = *it;
+        int oldHeight = nodes.get(*pathLink).height;
+
+        updateHeight(*pathLink);
+        if (mode == TreeMode::AVL)
+        {
+            *pathLink = rebalance(*pathLink);
+        }
+
+        if (nodes.get(*pathLink).height == oldHeight)
+        {
+            break;
+        }
+    }
+
+    root = top;
+    return true;
+}
+
 // =========================================
-// INSERTION OPERATION
+// CONCURRENT UPDATES
 // =========================================
 
 /**
- * Inserts a word into the BST
- * Maintains BST property: left < parent < right (alphabetically)
- * Time Complexity: O(log n) average, O(n) worst case
- * @param word: Word object to insert
+ * Switches the tree to concurrent mode (see insertConcurrent)
+ * @param epochs: Epoch manager shared with the readers
+ */
+void BinaryTree::enableConcurrentUpdates(EpochManager &epochs)
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+    this->epochs = &epochs;
+}
+
+/**
+ * Inserts a word by path copying, so readers never see a node change
+ * 1. Walk down from the root, recording the nodes passed and the direction taken
+ * 2. Create the new leaf, then copy the path bottom-up, linking each copy to the
+ *    copy below it and refreshing its height (and AVL balance). An insertion only
+ *    ever rotates nodes on its own path, so rotations only touch fresh copies
+ * 3. Publish the new root with one atomic store: a reader sees either the old
+ *    tree or the new one, never a mix
+ * 4. Retire the replaced path; it is recycled once every reader has moved on
+ * Costs O(height) new nodes per insertion instead of one; the caller holds writerMutex
+ * @param id: Record ID of the word to insert
+ * @return: True if a new node was created, false if the word is a duplicate
+ */
+bool BinaryTree::insertConcurrent(WordId id)
+{
+    reclaimRetired();
+
+    std::string_view name = store->get(id).getWord();
+    copyPath.clear();
+    NodeIndex node = root;
+    while (node != NULL_NODE)
+    {
+        int cmp = name.compare(keyOf(node));
+        if (cmp == 0)
+        {
+            return false; // Duplicate: nothing was copied yet
+        }
+        copyPath.emplace_back(node, cmp > 0);
+        node = (cmp < 0) ? nodes.get(node).left : nodes.get(node).right;
+    }
+
+    // Build the new version bottom-up; nothing is visible to readers yet
+    NodeIndex below = nodes.create(cursor, id);
+    for (auto it = copyPath.rbegin(); it != copyPath.rend(); ++it)
+    {
+        NodeIndex copy = nodes.create(cursor, nodes.get(it->first));
+        if (it->second)
+        {
+            nodes.get(copy).right = below;
+        }
+        else
+        {
+            nodes.get(copy).left = below;
+        }
+        updateHeight(copy);
+        below = (mode == TreeMode::AVL) ? rebalance(copy) : copy;
+    }
+
+    // Publish, then retire the replaced path under the epoch readers may still be in
+    root = below;
+    uint64_t epoch = epochs->retireEpoch();
+    for (const auto &step : copyPath)
+    {
+        retired.emplace_back(epoch, step.first);
+    }
+    return true;
+}
+
+/**
+ * Recycles retired nodes that no reader can reach any more
+ * Retired nodes are queued in epoch order, so the scan stops at the first
+ * node that may still be visible
+ */
+void BinaryTree::reclaimRetired()
+{
+    uint64_t safeEpoch = epochs->getSafeEpoch();
+    while (!retired.empty() && retired.front().first < safeEpoch)
+    {
+        nodes.recycle(cursor, retired.front().second, 1);
+        retired.pop_front();
+    }
+}
+
+// =========================================
+// BULK LOADING
+// =========================================
+
+/**
+ * Bulk-loads words into an empty BST as a minimum-height tree
+ * 1. Sort once (skipped when the input is already sorted, as dictionary.txt is)
+ * 2. Drop duplicates, keeping the first occurrence like insert() does
+ * 3. Build the tree in one pass, allocating nodes in sorted (in-order) order so that
+ *    neighbouring words sit next to each other in the arena
+ * The result is perfectly balanced, so it is also a valid AVL tree
+ * Time Complexity: O(n) for sorted input, O(n log n) otherwise
+ * @param ids: Record IDs of the words to load
  */
-void BinaryTree::insert(const Word &word)
+void BinaryTree::buildFromSorted(std::vector<WordId> ids)
 {
-    root = insertHelper(root, word);
-    nodeCount++;
+    // Bulk building only works on an empty, private tree; otherwise merge via normal insertion
+    if (root != NULL_NODE || epochs != nullptr)
+    {
+        for (WordId id : ids)
+        {
+            insert(id);
+        }
+        return;
+    }
+
+    const WordStore &records = *store;
+    auto wordLess = [&records](WordId a, WordId b)
+    { return records.get(a).getWord() < records.get(b).getWord(); };
+    auto wordEqual = [&records](WordId a, WordId b)
+    { return records.get(a).getWord() == records.get(b).getWord(); };
+
+    if (!std::is_sorted(ids.begin(), ids.end(), wordLess))
+    {
+        std::stable_sort(ids.begin(), ids.end(), wordLess);
+    }
+    ids.erase(std::unique(ids.begin(), ids.end(), wordEqual), ids.end());
+
+    if (ids.empty())
+    {
+        return;
+    }
+
+    root = buildFromSortedHelper(ids, 0, static_cast<int>(ids.size()) - 1);
+    nodeCount = static_cast<int>(ids.size());
 }
 
 /**
- * Recursive helper function to insert a word into the BST
- * Creates a new node if the correct position is found (nullptr)
- * Otherwise, recursively navigates left or right based on comparison
- * @param node: Current node being examined
- * @param word: Word object to insert
- * @return: Pointer to the root of this subtree (unchanged or newly created)
+ * Recursive helper to build a minimum-height subtree from ids[low..high]
+ * Recursion depth is O(log n) because the range halves at every level
+ * The left subtree is built before the node itself is allocated, so arena order is sorted order
+ * @param ids: Record IDs sorted by word, duplicate-free
+ * @param low: First index of the range (inclusive)
+ * @param high: Last index of the range (inclusive)
+ * @return: Root of the built subtree, or NULL_NODE for an empty range
  */
-TreeNode *BinaryTree::insertHelper(TreeNode *node, const Word &word)
+NodeIndex BinaryTree::buildFromSortedHelper(const std::vector<WordId> &ids, int low, int high)
 {
-    // Base case: found the insertion point (empty spot)
-    if (node == nullptr)
+    if (low > high)
     {
-        return new TreeNode(word);
+        return NULL_NODE;
     }
 
-    // Recursive case: navigate left or right based on alphabetical comparison
-    if (word < node->word)
+    int mid = low + (high - low) / 2;
+    NodeIndex left = buildFromSortedHelper(ids, low, mid - 1);
+    NodeIndex node = nodes.create(cursor, ids[mid]);
+
+    nodes.get(node).left = left;
+    nodes.get(node).right = buildFromSortedHelper(ids, mid + 1, high);
+    updateHeight(node);
+
+    return node;
+}
+
+// =========================================
+// SNAPSHOT
+// =========================================
+
+/**
+ * Adds the nodes to a snapshot
+ * A breadth-first walk assigns new indices in visiting order; element 0 is the unused NULL_NODE slot
+ * param0 = node count, param1 = tree mode
+ * @param writer: Snapshot being assembled
+ */
+void BinaryTree::writeSnapshot(SnapshotWriter &writer) const
+{
+    std::vector<TreeNode> dense(1, TreeNode(WordStore::INVALID_ID));
+    std::vector<NodeIndex> order; // Old indices in breadth-first order
+
+    if (root != NULL_NODE)
+    {
+        dense.reserve(static_cast<size_t>(nodeCount) + 1);
+        order.push_back(root);
+    }
+
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        TreeNode copy = nodes.get(order[i]);
+        if (copy.left != NULL_NODE)
+        {
+            order.push_back(copy.left);
+            copy.left = static_cast<NodeIndex>(order.size());
+        }
+        if (copy.right != NULL_NODE)
+        {
+            order.push_back(copy.right);
+            copy.right = static_cast<NodeIndex>(order.size());
+        }
+        dense.push_back(copy);
+    }
+
+    writer.addSection(SnapshotSection::TREE_NODES, dense.data(), dense.size() * sizeof(TreeNode),
+                      dense.size(), static_cast<uint64_t>(nodeCount), static_cast<uint64_t>(mode));
+}
+
+/**
+ * Uses the snapshot's node array in place as this tree's arena
+ * @param reader: Validated snapshot, already attached to the WordStore
+ * @return: False if the tree isn't empty, the section is missing or inconsistent or the mode differs
+ */
+bool BinaryTree::readSnapshot(const SnapshotReader &reader)
+{
+    if (root != NULL_NODE || !checkSnapshot(reader, static_cast<uint32_t>(store->size())))
+    {
+        return false;
+    }
+
+    const SnapshotSectionEntry *section = reader.find(SnapshotSection::TREE_NODES);
+
+    nodes.clear();
+    cursor = NodePool<TreeNode>::Cursor();
+    if (!nodes.adopt(reinterpret_cast<TreeNode *>(reader.data(*section)), section->count))
+    {
+        return false;
+    }
+
+    nodeCount = static_cast<int>(section->param0);
+    root = (nodeCount > 0) ? 1 : NULL_NODE;
+    return true;
+}
+
+/**
+ * Checks the node section before anything uses it
+ * Nodes are numbered breadth-first, so every child index is greater than its
+ * parent's: requiring that rules out cycles as well as out-of-range children
+ * @param reader: Validated snapshot
+ * @param recordCount: Number of records in the snapshot's WordStore
+ * @return: True if readSnapshot() would accept it for a tree in this mode
+ */
+bool BinaryTree::checkSnapshot(const SnapshotReader &reader, uint32_t recordCount) const
+{
+    const SnapshotSectionEntry *section = reader.find(SnapshotSection::TREE_NODES);
+    if (section == nullptr || section->count == 0 || section->param0 != section->count - 1 ||
+        section->param1 != static_cast<uint64_t>(mode))
+    {
+        return false;
+    }
+
+    const TreeNode *dense = reinterpret_cast<const TreeNode *>(reader.data(*section));
+    for (uint32_t i = 1; i < section->count; i++)
+    {
+        const TreeNode &node = dense[i];
+        if (node.wordId >= recordCount ||
+            (node.left != NULL_NODE && (node.left <= i || node.left >= section->count)) ||
+            (node.right != NULL_NODE && (node.right <= i || node.right >= section->count)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =========================================
+// AVL BALANCING
+// =========================================
+
+/**
+ * Returns the height of a subtree
+ * @param node: Root of the subtree
+ * @return: Height stored in the node, or 0 for an empty subtree
+ */
+int BinaryTree::heightOf(NodeIndex node) const
+{
+    return (node != NULL_NODE) ? nodes.get(node).height : 0;
+}
+
+/**
+ * Recomputes a node's height as 1 + the taller child's height
+ * @param node: Node to update
+ */
+void BinaryTree::updateHeight(NodeIndex node)
+{
+    TreeNode &current = nodes.get(node);
+    int leftHeight = heightOf(current.left);
+    int rightHeight = heightOf(current.right);
+    current.height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+}
+
+/**
+ * Left rotation:
+ *     node                 pivot
+ *    /    \               /     \
+ *   A    pivot    =>    node     C
+ *        /   \          /   \
+ *       B     C        A     B
+ * @param node: Root of the subtree
+ * @return: New root of the subtree (the former right child)
+ */
+NodeIndex BinaryTree::rotateLeft(NodeIndex node)
+{
+    NodeIndex pivot = nodes.get(node).right;
+    nodes.get(node).right = nodes.get(pivot).left;
+    nodes.get(pivot).left = node;
+
+    // Children first: node is now below pivot
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+/**
+ * Right rotation (mirror image of rotateLeft)
+ * @param node: Root of the subtree
+ * @return: New root of the subtree (the former left child)
+ */
+NodeIndex BinaryTree::rotateRight(NodeIndex node)
+{
+    NodeIndex pivot = nodes.get(node).left;
+    nodes.get(node).left = nodes.get(pivot).right;
+    nodes.get(pivot).right = node;
+
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+/**
+ * Restores the AVL property at a node
+ * Balance factor = height(left) - height(right); valid range is [-1, 1]
+ * - Left-Left / Right-Right cases need a single rotation
+ * - Left-Right / Right-Left cases rotate the child first (double rotation)
+ * @param node: Root of the subtree to rebalance
+ * @return: New root of the subtree
+ */
+NodeIndex BinaryTree::rebalance(NodeIndex node)
+{
+    TreeNode &current = nodes.get(node);
+    int balance = heightOf(current.left) - heightOf(current.right);
+
+    if (balance > 1)
     {
-        // Word comes alphabetically before current node -> go left
-        node->left = insertHelper(node->left, word);
+        // Left-heavy: convert Left-Right case into Left-Left first
+        const TreeNode &leftChild = nodes.get(current.left);
+        if (heightOf(leftChild.left) < heightOf(leftChild.right))
+        {
+            current.left = rotateLeft(current.left);
+        }
+        return rotateRight(node);
     }
-    else if (word > node->word)
+
+    if (balance < -1)
     {
-        // Word comes alphabetically after current node -> go right
-        node->right = insertHelper(node->right, word);
+        // Right-heavy: convert Right-Left case into Right-Right first
+        const TreeNode &rightChild = nodes.get(current.right);
+        if (heightOf(rightChild.right) < heightOf(rightChild.left))
+        {
+            current.right = rotateRight(current.right);
+        }
+        return rotateLeft(node);
     }
-    // If word == node->word, it's a duplicate - don't insert again
 
     return node;
 }
@@ -102,40 +505,316 @@ TreeNode *BinaryTree::insertHelper(TreeNode *node, const Word &word)
  * Uses binary search algorithm based on alphabetical ordering
  * Time Complexity: O(log n) average, O(n) worst case
  * @param name: Word to search for
- * @return: Pointer to Word object if found, nullptr otherwise
+ * @return: Pointer to the Word record if found, nullptr otherwise
  */
-Word *BinaryTree::search(const std::string &name) const
+const Word *BinaryTree::search(const std::string &name) const
 {
-    TreeNode *result = searchHelper(root, name);
-    return (result != nullptr) ? &(result->word) : nullptr;
+    NodeIndex result = searchHelper(name);
+    return (result != NULL_NODE) ? &store->get(nodes.get(result).wordId) : nullptr;
 }
 
 /**
- * Recursive helper function to search for a word in the BST
- * Uses binary search: compares and navigates left or right
- * @param node: Current node being examined
+ * Iterative helper function to search for a word in the BST
+ * Uses binary search: compares and navigates left or right until found or off the tree
  * @param name: Word to search for
- * @return: Pointer to TreeNode containing the word, or nullptr if not found
+ * @return: Node containing the word, or NULL_NODE if not found
+ */
+NodeIndex BinaryTree::searchHelper(const std::string &name) const
+{
+    NodeIndex node = root;
+
+    while (node != NULL_NODE)
+    {
+        const TreeNode &current = nodes.get(node);
+        int cmp = name.compare(store->get(current.wordId).getWord());
+        if (cmp == 0)
+        {
+            return node; // Found the word
+        }
+
+        // Search left (words alphabetically before) or right (words alphabetically after)
+        node = (cmp < 0) ? current.left : current.right;
+    }
+
+    return NULL_NODE;
+}
+
+/**
+ * TreeBatchLane - One in-flight lookup of searchBatch()
+ * Each comparison is three dependent loads (node, record, key text); the lane
+ * remembers which one it has just prefetched
+ */
+struct TreeBatchLane
+{
+    size_t key;         // Index of the name being looked up
+    NodeIndex node;     // Node being compared against
+    const Word *record; // Record of that node (valid from stage 1)
+    int stage;          // 0 = node prefetched, 1 = record prefetched, 2 = key text prefetched
+};
+
+/**
+ * Searches for many words at once, overlapping their cache misses (AMAC)
+ * Up to BATCH_WIDTH lookups are in flight. Each pass advances every lane by one
+ * load and prefetches the next one, so while one lane waits for memory the
+ * others do useful work; a finished lane immediately takes the next name.
+ * With one name this degenerates to search()
+ * @param names: Words to search for
+ * @param count: Number of words
+ * @param results: Receives one record pointer (or nullptr) per word
+ */
+void BinaryTree::searchBatch(const std::string_view *names, size_t count, const Word **results) const
+{
+    const size_t BATCH_WIDTH = 16;
+    TreeBatchLane lanes[BATCH_WIDTH];
+    size_t width = std::min(count, BATCH_WIDTH);
+    size_t nextKey = 0;
+    size_t active = 0;
+
+    // Points a lane at the next name (or retires it); false if none is left
+    auto start = [&](TreeBatchLane &lane) -> bool
+    {
+        while (nextKey < count)
+        {
+            size_t key = nextKey++;
+            if (root == NULL_NODE)
+            {
+                results[key] = nullptr;
+                continue;
+            }
+            lane = TreeBatchLane{key, root, nullptr, 0};
+            nodes.prefetch(root);
+            return true;
+        }
+        return false;
+    };
+
+    bool running[BATCH_WIDTH] = {};
+    for (size_t i = 0; i < width; i++)
+    {
+        running[i] = start(lanes[i]);
+        active += running[i] ? 1 : 0;
+    }
+
+    while (active > 0)
+    {
+        for (size_t i = 0; i < width; i++)
+        {
+            if (!running[i])
+            {
+                continue;
+            }
+
+            TreeBatchLane &lane = lanes[i];
+            if (lane.stage == 0)
+            {
+                lane.record = &store->get(nodes.get(lane.node).wordId);
+                prefetchLine(lane.record);
+                lane.stage = 1;
+            }
+            else if (lane.stage == 1)
+            {
+                prefetchLine(lane.record->getWord().data());
+                lane.stage = 2;
+            }
+            else
+            {
+                int cmp = names[lane.key].compare(lane.record->getWord());
+                NodeIndex next = (cmp < 0) ? nodes.get(lane.node).left : nodes.get(lane.node).right;
+                if (cmp == 0 || next == NULL_NODE)
+                {
+                    results[lane.key] = (cmp == 0) ? lane.record : nullptr;
+                    running[i] = start(lane);
+                    active -= running[i] ? 0 : 1;
+                    continue;
+                }
+                lane.node = next;
+                lane.stage = 0;
+                nodes.prefetch(next);
+            }
+        }
+    }
+}
+
+// =========================================
+// ORDERED ACCESS
+// =========================================
+
+/**
+ * Pushes a node and its chain of left children onto an iterator stack
+ * @param node: Root of the subtree (NULL_NODE pushes nothing)
+ * @param stack: Stack of ancestors still to be visited
+ */
+void BinaryTree::pushLeftSpine(NodeIndex node, std::vector<NodeIndex> &stack) const
+{
+    while (node != NULL_NODE)
+    {
+        stack.push_back(node);
+        node = nodes.get(node).left;
+    }
+}
+
+/**
+ * Iterator constructor (positioned at the end until its stack is filled)
+ * @param tree: Tree being walked
+ */
+BinaryTree::Iterator::Iterator(const BinaryTree *tree) : tree(tree)
+{
+}
+
+/**
+ * Returns the current word
+ * @return: Reference to the record in the WordStore
+ */
+const Word &BinaryTree::Iterator::operator*() const
+{
+    return tree->store->get(tree->nodes.get(stack.back()).wordId);
+}
+
+/**
+ * Returns the current word
+ * @return: Pointer to the record in the WordStore
  */
-TreeNode *BinaryTree::searchHelper(TreeNode *node, const std::string &name) const
+const Word *BinaryTree::Iterator::operator->() const
 {
-    // Base cases: empty tree or found the word
-    if (node == nullptr || node->word.getWord() == name)
+    return &**this;
+}
+
+/**
+ * Advances to the in-order successor
+ * The successor is the leftmost node of the right subtree if there is one,
+ * otherwise the nearest pending ancestor (already on the stack)
+ * @return: This iterator
+ */
+BinaryTree::Iterator &BinaryTree::Iterator::operator++()
+{
+    NodeIndex current = stack.back();
+    stack.pop_back();
+    tree->pushLeftSpine(tree->nodes.get(current).right, stack);
+    return *this;
+}
+
+/**
+ * Compares positions (all end iterators are equal)
+ * @param other: Iterator over the same tree
+ * @return: True if both are at the same node or both at the end
+ */
+bool BinaryTree::Iterator::operator==(const Iterator &other) const
+{
+    if (stack.empty() || other.stack.empty())
     {
-        return node;
+        return stack.empty() && other.stack.empty();
     }
+    return stack.back() == other.stack.back();
+}
 
-    // Recursive case: binary search
-    if (name < node->word.getWord())
+/**
+ * Compares positions
+ * @param other: Iterator over the same tree
+ * @return: True if the positions differ
+ */
+bool BinaryTree::Iterator::operator!=(const Iterator &other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * Returns an iterator at the alphabetically first word
+ * @return: Iterator (equal to end() for an empty tree)
+ */
+BinaryTree::Iterator BinaryTree::begin() const
+{
+    Iterator it(this);
+    it.stack.reserve(static_cast<size_t>(getHeight()));
+    pushLeftSpine(root, it.stack);
+    return it;
+}
+
+/**
+ * Returns the past-the-end iterator
+ * @return: End iterator
+ */
+BinaryTree::Iterator BinaryTree::end() const
+{
+    return Iterator(this);
+}
+
+/**
+ * Returns an iterator at the first word not less than a key
+ * One root-to-leaf descent: every node whose word is >= key is a pending
+ * ancestor (pushed, then go left); smaller nodes are skipped (go right)
+ * @param key: Key to position at
+ * @return: Iterator, or end() if every word is less than the key
+ */
+BinaryTree::Iterator BinaryTree::lower_bound(std::string_view key) const
+{
+    Iterator it(this);
+    NodeIndex node = root;
+    while (node != NULL_NODE)
     {
-        // Search in left subtree (words alphabetically before)
-        return searchHelper(node->left, name);
+        const TreeNode &current = nodes.get(node);
+        if (keyOf(node).compare(key) >= 0)
+        {
+            it.stack.push_back(node);
+            node = current.left;
+        }
+        else
+        {
+            node = current.right;
+        }
+    }
+    return it;
+}
+
+/**
+ * Returns an iterator at the first word greater than a key
+ * Same descent as lower_bound(), with words equal to the key skipped
+ * @param key: Key to position after
+ * @return: Iterator, or end() if no word is greater than the key
+ */
+BinaryTree::Iterator BinaryTree::upper_bound(std::string_view key) const
+{
+    Iterator it(this);
+    NodeIndex node = root;
+    while (node != NULL_NODE)
+    {
+        const TreeNode &current = nodes.get(node);
+        if (keyOf(node).compare(key) > 0)
+        {
+            it.stack.push_back(node);
+            node = current.left;
+        }
+        else
+        {
+            node = current.right;
+        }
     }
-    else
+    return it;
+}
+
+/**
+ * Streams the words in [lo, hi] in alphabetical order
+ * Positions once with lower_bound(), then steps the iterator until a word
+ * exceeds hi, so only the delivered words (and one more) are visited
+ * @param lo: Smallest word to include
+ * @param hi: Largest word to include
+ * @param limit: Maximum number of results (negative = unlimited)
+ * @param callback: Called once per word in range
+ * @return: Number of results delivered
+ */
+int BinaryTree::range(std::string_view lo, std::string_view hi, int limit,
+                      const std::function<void(const Word &)> &callback) const
+{
+    int delivered = 0;
+    for (Iterator it = lower_bound(lo); it != end() && delivered != limit; ++it)
     {
-        // Search in right subtree (words alphabetically after)
-        return searchHelper(node->right, name);
+        if (it->getWord().compare(hi) > 0)
+        {
+            break;
+        }
+        callback(*it);
+        delivered++;
     }
+    return delivered;
 }
 
 // =========================================
@@ -149,7 +828,7 @@ TreeNode *BinaryTree::searchHelper(TreeNode *node, const std::string &name) cons
  * @param result: Reference parameter to store search result
  * @return: Time taken for the search in nanoseconds
  */
-long long BinaryTree::searchWithTiming(const std::string &name, Word *&result)
+long long BinaryTree::searchWithTiming(const std::string &name, const Word *&result)
 {
     // Record start time with high precision
     auto start = std::chrono::high_resolution_clock::now();
@@ -170,46 +849,41 @@ long long BinaryTree::searchWithTiming(const std::string &name, Word *&result)
 // =========================================
 
 /**
- * Calculates total memory usage of the BST
- * @return: Total memory in bytes
+ * Calculates the memory used by the BST index
+ * Word data lives in the WordStore, so this is just the node arena (whole chunks)
+ * @return: Total node memory in bytes
  */
-int BinaryTree::getMemoryUsage() const
+long long BinaryTree::getMemoryUsage() const
 {
-    return getMemorySize(root);
+    return nodes.getMemoryUsage();
 }
 
 /**
- * Recursively calculates memory size of the BST starting from a node
- * Includes: node size, Word object size, and string capacities
- * @param node: Current node being measured
- * @return: Memory size in bytes
+ * Returns the total number of nodes in the BST
+ * @return: Node count
  */
-int BinaryTree::getMemorySize(TreeNode *node) const
+int BinaryTree::getNodeCount() const
 {
-    if (node == nullptr)
-    {
-        return 0;
-    }
-
-    // Size of TreeNode structure itself
-    int currentSize = sizeof(TreeNode);
-
-    // Add the actual string storage capacity for Word's strings
-    currentSize += node->word.getWord().capacity();
-    currentSize += node->word.getPartOfSpeech().capacity();
-    currentSize += node->word.getDefinition().capacity();
+    return nodeCount;
+}
 
-    // Recursively add memory of left and right subtrees
-    return currentSize + getMemorySize(node->left) + getMemorySize(node->right);
+/**
+ * Returns the height of the BST
+ * Heights are maintained on every insertion, so this is O(1)
+ * @return: Tree height (0 for an empty tree)
+ */
+int BinaryTree::getHeight() const
+{
+    return heightOf(root);
 }
 
 /**
- * Returns the total number of nodes in the BST
- * @return: Node count
+ * Returns the balancing strategy of the BST
+ * @return: Tree mode
  */
-int BinaryTree::getNodeCount() const
+TreeMode BinaryTree::getMode() const
 {
-    return nodeCount;
+    return mode;
 }
 
 // =========================================
@@ -223,7 +897,7 @@ int BinaryTree::getNodeCount() const
  */
 void BinaryTree::displayTree() const
 {
-    if (root == nullptr)
+    if (root == NULL_NODE)
     {
         std::cout << "Tree is empty!" << std::endl;
         return;
@@ -246,10 +920,10 @@ void BinaryTree::displayTree() const
  * @param count: Current count of nodes displayed (reference)
  * @param maxCount: Maximum number of nodes to display
  */
-void BinaryTree::displayTreeHelper(TreeNode *node, std::string prefix, bool isLeft, int &count, int maxCount) const
+void BinaryTree::displayTreeHelper(NodeIndex node, std::string prefix, bool isLeft, int &count, int maxCount) const
 {
     // Base cases: null node or reached display limit
-    if (node == nullptr || count >= maxCount)
+    if (node == NULL_NODE || count >= maxCount)
     {
         return;
     }
@@ -257,7 +931,7 @@ void BinaryTree::displayTreeHelper(TreeNode *node, std::string prefix, bool isLe
     // Display current node with appropriate tree branch symbol
     std::cout << prefix;
     std::cout << (isLeft ? "|--L: " : "+--R: ");
-    std::cout << node->word.getWord() << std::endl;
+    std::cout << keyOf(node) << std::endl;
     count++;
 
     // Stop if we've reached the display limit
@@ -267,12 +941,13 @@ void BinaryTree::displayTreeHelper(TreeNode *node, std::string prefix, bool isLe
     }
 
     // Recursively display children if they exist
-    if (node->left != nullptr || node->right != nullptr)
+    const TreeNode &current = nodes.get(node);
+    if (current.left != NULL_NODE || current.right != NULL_NODE)
     {
         // Display left subtree
-        if (node->left != nullptr)
+        if (current.left != NULL_NODE)
         {
-            displayTreeHelper(node->left,
+            displayTreeHelper(current.left,
                               prefix + (isLeft ? "|   " : "    "),
                               true,
                               count,
@@ -280,9 +955,9 @@ void BinaryTree::displayTreeHelper(TreeNode *node, std::string prefix, bool isLe
         }
 
         // Display right subtree
-        if (node->right != nullptr && count < maxCount)
+        if (current.right != NULL_NODE && count < maxCount)
         {
-            displayTreeHelper(node->right,
+            displayTreeHelper(current.right,
                               prefix + (isLeft ? "|   " : "    "),
                               false,
                               count,
@@ -1,72 +1,173 @@
 #ifndef BINARYTREE_H
 #define BINARYTREE_H
 
-#include "Word.h"
+#include "WordStore.h"
+#include "NodePool.h"
+#include "Snapshot.h"
+#include "EpochManager.h"
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <queue>
+#include <string_view>
+#include <vector>
+
+/**
+ * TreeMode - Balancing strategy used by the BinaryTree
+ * Selected once at construction time
+ */
+enum class TreeMode
+{
+    UNBALANCED, // Plain BST insertion (degrades to a linked list on sorted input)
+    AVL         // Self-balancing AVL tree, height stays O(log n) on any input
+};
 
 /**
  * TreeNode - Node in the Binary Search Tree
- * Each node stores a complete Word object and pointers to left/right children
+ * Each node references its word's record in the shared WordStore and
+ * holds 32-bit pool indices of its left/right children (16 bytes per node)
  */
 class TreeNode
 {
 public:
-    Word word;       // Complete word data (word, part of speech, definition)
-    TreeNode *left;  // Pointer to left child (words alphabetically before this word)
-    TreeNode *right; // Pointer to right child (words alphabetically after this word)
+    WordId wordId;   // ID of the word's record in the WordStore
+    int height;      // Height of the subtree rooted at this node (leaf = 1)
+    NodeIndex left;  // Left child (words alphabetically before this word), NULL_NODE if none
+    NodeIndex right; // Right child (words alphabetically after this word), NULL_NODE if none
 
     /**
      * Constructor
-     * @param wd: Word object to store in this node
+     * @param id: Record ID of the word stored in this node
      */
-    TreeNode(const Word &wd);
+    TreeNode(WordId id);
 };
 
 /**
  * BinaryTree - Binary Search Tree implementation
  * Maintains BST property: left child < parent < right child (alphabetically)
+ * Nodes are allocated from a per-tree NodePool, so destruction is one O(chunks) release
  * Time Complexity: O(log n) average case, O(n) worst case for unbalanced tree
+ *                  O(log n) worst case in AVL mode
+ * In concurrent mode (enableConcurrentUpdates) insertions copy the search path and
+ * publish a new root atomically, so lock-free readers holding an EpochGuard can
+ * keep searching while words are added
  */
 class BinaryTree
 {
 private:
-    TreeNode *root; // Root node of the BST
+    const WordStore *store; // Shared record store that node IDs refer to
+    NodePool<TreeNode> nodes;          // Arena holding every node
+    NodePool<TreeNode>::Cursor cursor; // Allocation position inside the arena
+    std::atomic<NodeIndex> root; // Root node of the BST (NULL_NODE if empty)
     int nodeCount;  // Total number of nodes in the tree
+    TreeMode mode;  // Balancing strategy chosen at construction
+
+    std::vector<NodeIndex *> insertPath; // Reused insertion path (links from root to new node)
+
+    // Concurrent mode (epochs == nullptr: plain in-place updates)
+    EpochManager *epochs;                                // Reader epochs guarding unlinked nodes
+    std::mutex writerMutex;                              // Serializes writers (readers never take it)
+    std::vector<std::pair<NodeIndex, bool>> copyPath;    // Reused search path (node, went right)
+    std::deque<std::pair<uint64_t, NodeIndex>> retired;  // Replaced nodes and the epoch they were unlinked in
 
     // === PRIVATE HELPER FUNCTIONS ===
 
     /**
-     * Recursive helper to insert a word into the BST
-     * Maintains BST property during insertion
-     * @param node: Current node being examined
-     * @param word: Word object to insert
-     * @return: Pointer to the (possibly new) root of this subtree
+     * Iterative helper to insert a word into the BST
+     * Maintains BST property during insertion (and AVL balance in AVL mode)
+     * Records the descent path on the heap instead of the call stack
+     * @param id: Record ID of the word to insert
+     * @return: True if a new node was created, false for a duplicate
+     */
+    bool insertHelper(WordId id);
+
+    /**
+     * Inserts a word without disturbing concurrent readers (concurrent mode only)
+     * Copies the nodes on the search path, rebalances the copies and publishes
+     * the new root with one atomic store; the old path is retired
+     * @param id: Record ID of the word to insert
+     * @return: True if a new node was created, false for a duplicate
+     */
+    bool insertConcurrent(WordId id);
+
+    /**
+     * Recycles retired nodes that no reader can reach any more
+     */
+    void reclaimRetired();
+
+    /**
+     * Gets the word text a node is keyed by
+     * @param node: Node to read
+     * @return: View of the word text in the WordStore
+     */
+    std::string_view keyOf(NodeIndex node) const;
+
+    // === AVL BALANCING HELPERS ===
+
+    /**
+     * Returns the height of a subtree (0 for an empty subtree)
+     * @param node: Root of the subtree
+     * @return: Subtree height
+     */
+    int heightOf(NodeIndex node) const;
+
+    /**
+     * Recomputes a node's height from its children
+     * @param node: Node to update
+     */
+    void updateHeight(NodeIndex node);
+
+    /**
+     * Rotates a subtree to the left (right child becomes the new root)
+     * @param node: Root of the subtree
+     * @return: New root of the subtree
      */
-    TreeNode *insertHelper(TreeNode *node, const Word &word);
+    NodeIndex rotateLeft(NodeIndex node);
 
     /**
-     * Recursive helper to search for a word in the BST
+     * Rotates a subtree to the right (left child becomes the new root)
+     * @param node: Root of the subtree
+     * @return: New root of the subtree
+     */
+    NodeIndex rotateRight(NodeIndex node);
+
+    /**
+     * Restores the AVL property at a node after an insertion below it
+     * Applies a single or double rotation when the balance factor leaves [-1, 1]
+     * @param node: Root of the subtree to rebalance
+     * @return: New root of the subtree
+     */
+    NodeIndex rebalance(NodeIndex node);
+
+    /**
+     * Iterative helper to search for a word in the BST
      * Uses binary search based on alphabetical comparison
-     * @param node: Current node being examined
      * @param name: Word to search for
-     * @return: Pointer to the node containing the word, or nullptr if not found
+     * @return: Node containing the word, or NULL_NODE if not found
      */
-    TreeNode *searchHelper(TreeNode *node, const std::string &name) const;
+    NodeIndex searchHelper(const std::string &name) const;
 
     /**
-     * Recursively destroys all nodes in the tree
-     * Post-order traversal: destroys children first, then parent
-     * @param node: Current node to destroy
+     * Pushes a node and its chain of left children onto an iterator stack
+     * so the stack's top becomes the smallest word of that subtree
+     * @param node: Root of the subtree (NULL_NODE pushes nothing)
+     * @param stack: Stack of ancestors still to be visited
      */
-    void destroyTree(TreeNode *node);
+    void pushLeftSpine(NodeIndex node, std::vector<NodeIndex> &stack) const;
 
     /**
-     * Recursively calculates memory usage of the tree
-     * @param node: Current node being measured
-     * @return: Memory size in bytes
+     * Recursive helper to build a minimum-height subtree from a sorted range
+     * The middle word becomes the subtree root; halves become the children
+     * @param ids: Record IDs sorted by word, duplicate-free
+     * @param low: First index of the range (inclusive)
+     * @param high: Last index of the range (inclusive)
+     * @return: Root of the built subtree, or NULL_NODE for an empty range
      */
-    int getMemorySize(TreeNode *node) const;
+    NodeIndex buildFromSortedHelper(const std::vector<WordId> &ids, int low, int high);
 
     /**
      * Recursive helper to display tree structure visually
@@ -76,29 +177,189 @@ private:
      * @param count: Current count of nodes displayed (reference)
      * @param maxCount: Maximum number of nodes to display
      */
-    void displayTreeHelper(TreeNode *node, std::string prefix, bool isLeft, int &count, int maxCount) const;
+    void displayTreeHelper(NodeIndex node, std::string prefix, bool isLeft, int &count, int maxCount) const;
 
 public:
+    /**
+     * Iterator - Stackful in-order (alphabetical) iterator over the tree's words
+     * Holds the path of ancestors still to be visited, so it needs no parent links:
+     * O(height) memory, O(1) amortized per step, O(log n) to position in AVL mode
+     * Invalidated by insert() and buildFromSorted()
+     */
+    class Iterator
+    {
+    private:
+        const BinaryTree *tree;       // Tree being walked
+        std::vector<NodeIndex> stack; // Pending ancestors; the top is the current node (empty = end)
+
+        friend class BinaryTree;
+
+        /**
+         * Constructor used by begin()/end()/lower_bound()/upper_bound()
+         * @param tree: Tree being walked
+         */
+        Iterator(const BinaryTree *tree);
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Word;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Word *;
+        using reference = const Word &;
+
+        /**
+         * Gets the current word
+         * @return: Reference to the record in the WordStore
+         */
+        const Word &operator*() const;
+
+        /**
+         * Gets the current word
+         * @return: Pointer to the record in the WordStore
+         */
+        const Word *operator->() const;
+
+        /**
+         * Advances to the next word alphabetically
+         * @return: This iterator
+         */
+        Iterator &operator++();
+
+        /**
+         * Compares positions (all end iterators are equal)
+         * @param other: Iterator over the same tree
+         * @return: True if both are at the same node or both at the end
+         */
+        bool operator==(const Iterator &other) const;
+
+        /**
+         * Compares positions
+         * @param other: Iterator over the same tree
+         * @return: True if the positions differ
+         */
+        bool operator!=(const Iterator &other) const;
+    };
+
     // === CONSTRUCTOR & DESTRUCTOR ===
-    BinaryTree();
-    ~BinaryTree();
+
+    /**
+     * Constructor
+     * @param store: Record store holding the words (must outlive the tree)
+     * @param mode: Balancing strategy (defaults to a plain unbalanced BST)
+     * @param hugePages: Back the node arena with huge pages where supported
+     */
+    BinaryTree(const WordStore &store, TreeMode mode = TreeMode::UNBALANCED, bool hugePages = false);
 
     // === MAIN OPERATIONS ===
 
     /**
      * Inserts a word into the BST
      * Maintains BST property: left < parent < right (alphabetically)
-     * @param word: Word object to insert
+     * Safe to call while readers run once concurrent updates are enabled
+     * @param id: Record ID of the word in the WordStore
+     */
+    void insert(WordId id);
+
+    /**
+     * Switches the tree to concurrent mode: from now on insert() copies the
+     * search path instead of updating nodes in place, and replaced nodes are
+     * reused only once no reader registered with the manager can see them
+     * Readers must hold an EpochGuard for as long as they use results, nodes or
+     * iterators from the tree. Call before any reader starts
+     * @param epochs: Epoch manager shared with the readers (must outlive the tree)
      */
-    void insert(const Word &word);
+    void enableConcurrentUpdates(EpochManager &epochs);
+
+    /**
+     * Bulk-loads words into an empty BST as a minimum-height tree
+     * Sorts the IDs by word once if they aren't already sorted and drops duplicates,
+     * then builds the tree in a single O(n) pass with nodes laid out in sorted order
+     * If the tree already contains words (or is in concurrent mode), falls back to
+     * inserting them one by one
+     * @param ids: Record IDs of the words to load
+     */
+    void buildFromSorted(std::vector<WordId> ids);
 
     /**
      * Searches for a word in the BST
      * Case-sensitive search using binary search algorithm
      * @param name: Word to search for
-     * @return: Pointer to Word object if found, nullptr otherwise
+     * @return: Pointer to the Word record if found, nullptr otherwise
+     */
+    const Word *search(const std::string &name) const;
+
+    /**
+     * Searches for many words at once, overlapping their cache misses
+     * Same results as calling search() on each name
+     * @param names: Words to search for
+     * @param count: Number of words
+     * @param results: Receives one record pointer (or nullptr) per word
+     */
+    void searchBatch(const std::string_view *names, size_t count, const Word **results) const;
+
+    // === ORDERED ACCESS ===
+
+    /**
+     * Gets an iterator at the alphabetically first word
+     * @return: Iterator (equal to end() for an empty tree)
+     */
+    Iterator begin() const;
+
+    /**
+     * Gets the past-the-end iterator
+     * @return: End iterator
+     */
+    Iterator end() const;
+
+    /**
+     * Gets an iterator at the first word not less than a key (case-sensitive, like search)
+     * @param key: Key to position at
+     * @return: Iterator, or end() if every word is less than the key
      */
-    Word *search(const std::string &name) const;
+    Iterator lower_bound(std::string_view key) const;
+
+    /**
+     * Gets an iterator at the first word greater than a key ("the words after X")
+     * @param key: Key to position after
+     * @return: Iterator, or end() if no word is greater than the key
+     */
+    Iterator upper_bound(std::string_view key) const;
+
+    /**
+     * Streams the words in [lo, hi] in alphabetical order without collecting them
+     * Time Complexity: O(log n + k) in AVL mode, k = words delivered
+     * @param lo: Smallest word to include
+     * @param hi: Largest word to include
+     * @param limit: Maximum number of results (negative = unlimited)
+     * @param callback: Called once per word in range
+     * @return: Number of results delivered
+     */
+    int range(std::string_view lo, std::string_view hi, int limit,
+              const std::function<void(const Word &)> &callback) const;
+
+    // === SNAPSHOT ===
+
+    /**
+     * Adds the nodes to a snapshot, renumbered densely in breadth-first order
+     * (root = 1), so the top levels of the tree share cache lines
+     * @param writer: Snapshot being assembled
+     */
+    void writeSnapshot(SnapshotWriter &writer) const;
+
+    /**
+     * Uses the snapshot's node array in place as this (empty) tree's arena
+     * @param reader: Validated snapshot, already attached to the WordStore
+     * @return: False if the tree isn't empty, the section is missing or inconsistent or the mode differs
+     */
+    bool readSnapshot(const SnapshotReader &reader);
+
+    /**
+     * Checks the node section without adopting it
+     * @param reader: Validated snapshot
+     * @param recordCount: Number of records in the snapshot's WordStore
+     * @return: True if readSnapshot() would accept it for a tree in this mode
+     */
+    bool checkSnapshot(const SnapshotReader &reader, uint32_t recordCount) const;
 
     // === PERFORMANCE METRICS ===
 
@@ -108,13 +369,14 @@ public:
      * @param result: Reference parameter to store search result
      * @return: Search time in nanoseconds
      */
-    long long searchWithTiming(const std::string &name, Word *&result);
+    long long searchWithTiming(const std::string &name, const Word *&result);
 
     /**
-     * Gets the total memory usage of the BST
+     * Gets the memory used by the BST index itself (the node arena)
+     * Word records are owned by the WordStore and reported there
      * @return: Memory used in bytes
      */
-    int getMemoryUsage() const;
+    long long getMemoryUsage() const;
 
     /**
      * Gets the total number of nodes in the BST
@@ -122,6 +384,19 @@ public:
      */
     int getNodeCount() const;
 
+    /**
+     * Gets the height of the BST (number of nodes on the longest root-to-leaf path)
+     * Equals the worst-case number of comparisons for a search
+     * @return: Tree height (0 for an empty tree)
+     */
+    int getHeight() const;
+
+    /**
+     * Gets the balancing strategy the tree was constructed with
+     * @return: Tree mode
+     */
+    TreeMode getMode() const;
+
     // === DISPLAY ===
 
     /**
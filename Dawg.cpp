@@ -0,0 +1,408 @@
+#include "Dawg.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+#include <utility>
+
+// =========================================
+// CONSTRUCTOR
+// =========================================
+
+/**
+ * Dawg Constructor
+ * Creates an empty automaton; call build() once the store is loaded
+ * @param store: Record store holding the words (must outlive the DAWG)
+ */
+Dawg::Dawg(const WordStore &store) : store(&store) {}
+
+// =========================================
+// CONSTRUCTION (INCREMENTAL MINIMIZATION)
+// =========================================
+
+/**
+ * DawgBuildState - Mutable state used only while building
+ * Edges are appended in sorted order because keys arrive sorted
+ */
+struct DawgBuildState
+{
+    bool isFinal;
+    std::vector<std::pair<unsigned char, uint32_t>> edges;
+};
+
+/**
+ * DawgPendingEdge - Edge on the path of the previous key whose target has
+ * not been checked against the register yet
+ */
+struct DawgPendingEdge
+{
+    uint32_t parent;
+    uint32_t child;
+};
+
+/**
+ * Builds the register key of a state: its final flag plus (label, target)
+ * of every edge. Targets are already canonical, so equal keys mean equal
+ * right languages
+ * @param state: State to describe
+ * @return: Signature bytes
+ */
+static std::string signatureOf(const DawgBuildState &state)
+{
+    std::string signature;
+    signature.reserve(1 + state.edges.size() * 5);
+    signature.push_back(state.isFinal ? '1' : '0');
+
+    for (const auto &edge : state.edges)
+    {
+        signature.push_back(static_cast<char>(edge.first));
+        signature.append(reinterpret_cast<const char *>(&edge.second), sizeof(edge.second));
+    }
+    return signature;
+}
+
+/**
+ * Builds the minimized automaton from every record in the WordStore
+ */
+void Dawg::build()
+{
+    // Collect (lowercase key, record ID) and sort; equal keys end up ordered by ID
+    std::vector<std::pair<std::string, WordId>> keys;
+    keys.reserve(store->size());
+
+    for (WordId id = 0; id < static_cast<WordId>(store->size()); id++)
+    {
+        std::string_view name = store->get(id).getWord();
+        std::string key(name);
+        for (char &c : key)
+        {
+            c = tolower(c);
+        }
+        keys.emplace_back(std::move(key), id);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // Keep the last (highest) ID of each run of equal keys
+    size_t unique = 0;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (unique > 0 && keys[unique - 1].first == keys[i].first)
+        {
+            keys[unique - 1].second = keys[i].second;
+        }
+        else
+        {
+            if (unique != i)
+            {
+                keys[unique] = std::move(keys[i]);
+            }
+            unique++;
+        }
+    }
+    keys.resize(unique);
+
+    std::vector<DawgBuildState> states(1, DawgBuildState{false, {}});
+    std::vector<DawgPendingEdge> unchecked;
+    std::unordered_map<std::string, uint32_t> registry;
+    std::vector<uint32_t> registered; // Canonical states in registration (children-first) order
+
+    // Replace or register the pending path below depth downTo, deepest first
+    auto minimize = [&](size_t downTo)
+    {
+        while (unchecked.size() > downTo)
+        {
+            DawgPendingEdge pending = unchecked.back();
+            unchecked.pop_back();
+
+            std::string signature = signatureOf(states[pending.child]);
+            auto existing = registry.find(signature);
+            if (existing != registry.end())
+            {
+                states[pending.parent].edges.back().second = existing->second;
+                states[pending.child].edges.clear();
+                states[pending.child].edges.shrink_to_fit();
+            }
+            else
+            {
+                registry.emplace(std::move(signature), pending.child);
+                registered.push_back(pending.child);
+            }
+        }
+    };
+
+    const std::string *previous = nullptr;
+    for (const auto &entry : keys)
+    {
+        const std::string &key = entry.first;
+
+        size_t common = 0;
+        if (previous != nullptr)
+        {
+            size_t limit = std::min(previous->size(), key.size());
+            while (common < limit && (*previous)[common] == key[common])
+            {
+                common++;
+            }
+        }
+        minimize(common);
+
+        uint32_t state = unchecked.empty() ? 0 : unchecked.back().child;
+        for (size_t i = common; i < key.size(); i++)
+        {
+            uint32_t next = static_cast<uint32_t>(states.size());
+            states.push_back(DawgBuildState{false, {}});
+            states[state].edges.emplace_back(static_cast<unsigned char>(key[i]), next);
+            unchecked.push_back(DawgPendingEdge{state, next});
+            state = next;
+        }
+        states[state].isFinal = true;
+        previous = &key;
+    }
+    minimize(0);
+
+    // Renumber the live states: start state first, then canonical states
+    std::vector<uint32_t> newIndex(states.size(), 0);
+    std::vector<uint32_t> order;
+    order.reserve(registered.size() + 1);
+    order.push_back(0);
+    for (uint32_t state : registered)
+    {
+        newIndex[state] = static_cast<uint32_t>(order.size());
+        order.push_back(state);
+    }
+
+    // Number of accepted keys below each state; registration order is children-first
+    std::vector<uint32_t> keyCount(states.size(), 0);
+    auto countKeys = [&](uint32_t state)
+    {
+        uint32_t count = states[state].isFinal ? 1 : 0;
+        for (const auto &edge : states[state].edges)
+        {
+            count += keyCount[edge.second];
+        }
+        keyCount[state] = count;
+    };
+    for (uint32_t state : registered)
+    {
+        countKeys(state);
+    }
+    countKeys(0);
+
+    // Freeze into flat arrays, turning key counts into per-edge skip values
+    stateFirstEdge.assign(1, 0);
+    stateFinal.clear();
+    edgeLabel.clear();
+    edgeTarget.clear();
+    edgeSkip.clear();
+    stateFirstEdge.reserve(order.size() + 1);
+    stateFinal.reserve(order.size());
+
+    for (uint32_t state : order)
+    {
+        const DawgBuildState &current = states[state];
+        uint32_t skip = current.isFinal ? 1 : 0;
+
+        for (const auto &edge : current.edges)
+        {
+            edgeLabel.push_back(edge.first);
+            edgeTarget.push_back(newIndex[edge.second]);
+            edgeSkip.push_back(skip);
+            skip += keyCount[edge.second];
+        }
+        stateFinal.push_back(current.isFinal ? 1 : 0);
+        stateFirstEdge.push_back(static_cast<uint32_t>(edgeLabel.size()));
+    }
+    edgeLabel.shrink_to_fit();
+    edgeTarget.shrink_to_fit();
+    edgeSkip.shrink_to_fit();
+
+    // Rank i is the i-th key in sorted order
+    rankToRecord.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        rankToRecord[i] = keys[i].second;
+    }
+}
+
+// =========================================
+// SEARCH OPERATIONS
+// =========================================
+
+/**
+ * Follows the edge for a character out of a state
+ * Labels are sorted, so the scan stops at the first larger label
+ * @param state: Current state
+ * @param c: Lowercase character
+ * @param rank: Increased by the edge's skip value when the edge exists
+ * @return: Target state, or -1 if there is no such edge
+ */
+long long Dawg::step(uint32_t state, unsigned char c, uint32_t &rank) const
+{
+    for (uint32_t e = stateFirstEdge[state]; e < stateFirstEdge[state + 1]; e++)
+    {
+        if (edgeLabel[e] == c)
+        {
+            rank += edgeSkip[e];
+            return edgeTarget[e];
+        }
+        if (edgeLabel[e] > c)
+        {
+            break;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Searches for a word (case-insensitive)
+ * The rank accumulated along the path is the key's perfect hash
+ * @param name: Word to search for
+ * @return: Pointer to the Word record if found, nullptr otherwise
+ */
+const Word *Dawg::search(const std::string &name) const
+{
+    if (stateFinal.empty())
+    {
+        return nullptr;
+    }
+
+    uint32_t state = 0;
+    uint32_t rank = 0;
+
+    for (char c : name)
+    {
+        long long next = step(state, static_cast<unsigned char>(tolower(c)), rank);
+        if (next < 0)
+        {
+            return nullptr;
+        }
+        state = static_cast<uint32_t>(next);
+    }
+
+    if (!stateFinal[state])
+    {
+        return nullptr;
+    }
+    return &store->get(rankToRecord[rank]);
+}
+
+/**
+ * Streams every word starting with a prefix in lexicographic order
+ * The keys below a state occupy one contiguous run of ranks, so after walking
+ * the prefix the results are simply rankToRecord[rank, rank + count)
+ * @param prefix: Prefix to match (case-insensitive)
+ * @param limit: Maximum number of results (negative = unlimited)
+ * @param callback: Called once per matching record
+ * @return: Number of results delivered
+ */
+int Dawg::forEachWithPrefix(const std::string &prefix, int limit,
+                            const std::function<void(const Word &)> &callback) const
+{
+    if (stateFinal.empty())
+    {
+        return 0;
+    }
+
+    uint32_t state = 0;
+    uint32_t rank = 0;
+
+    for (char c : prefix)
+    {
+        long long next = step(state, static_cast<unsigned char>(tolower(c)), rank);
+        if (next < 0)
+        {
+            return 0;
+        }
+        state = static_cast<uint32_t>(next);
+    }
+
+    // Keys below the state = skip of its last edge + keys below that edge's target
+    uint32_t count = 0;
+    uint32_t current = state;
+    while (stateFirstEdge[current] != stateFirstEdge[current + 1])
+    {
+        uint32_t last = stateFirstEdge[current + 1] - 1;
+        count += edgeSkip[last];
+        current = edgeTarget[last];
+    }
+    count += stateFinal[current];
+
+    if (limit >= 0 && count > static_cast<uint32_t>(limit))
+    {
+        count = static_cast<uint32_t>(limit);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        callback(store->get(rankToRecord[rank + i]));
+    }
+    return static_cast<int>(count);
+}
+
+// =========================================
+// PERFORMANCE MEASUREMENT
+// =========================================
+
+/**
+ * Searches for a word and measures execution time
+ * @param name: Word to search for
+ * @param result: Reference parameter to store search result
+ * @return: Search time in nanoseconds
+ */
+long long Dawg::searchWithTiming(const std::string &name, const Word *&result)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    result = search(name);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// =========================================
+// MEMORY USAGE CALCULATION
+// =========================================
+
+/**
+ * Calculates the memory used by the automaton arrays and the rank table
+ * @return: Memory used in bytes
+ */
+long long Dawg::getMemoryUsage() const
+{
+    return static_cast<long long>(stateFirstEdge.size() * sizeof(uint32_t) +
+                                  stateFinal.size() * sizeof(uint8_t) +
+                                  edgeLabel.size() * sizeof(unsigned char) +
+                                  edgeTarget.size() * sizeof(uint32_t) +
+                                  edgeSkip.size() * sizeof(uint32_t) +
+                                  rankToRecord.size() * sizeof(WordId));
+}
+
+// =========================================
+// GETTERS
+// =========================================
+
+/**
+ * Gets the number of states
+ * @return: State count
+ */
+int Dawg::getNodeCount() const
+{
+    return static_cast<int>(stateFinal.size());
+}
+
+/**
+ * Gets the number of edges
+ * @return: Edge count
+ */
+int Dawg::getEdgeCount() const
+{
+    return static_cast<int>(edgeLabel.size());
+}
+
+/**
+ * Gets the number of distinct (lowercased) keys
+ * @return: Key count
+ */
+int Dawg::getKeyCount() const
+{
+    return static_cast<int>(rankToRecord.size());
+}
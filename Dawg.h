@@ -0,0 +1,115 @@
+#ifndef DAWG_H
+#define DAWG_H
+
+#include "WordStore.h"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Dawg - Minimized acyclic automaton (DAWG) over the lowercased headwords
+ * Shares suffixes ("-ism", "-ness", "-ation") as well as prefixes, so the key
+ * index is far smaller than a Trie. Every accepting path is numbered by perfect
+ * hashing along the edges: each edge carries the number of keys that sort
+ * before any key using it, so summing them while walking yields the key's rank,
+ * which indexes the rank -> record ID table
+ * Read-only: built once from the WordStore with build()
+ * Time Complexity: O(m * s) lookup, m = word length, s = small per-state fan-out
+ */
+class Dawg
+{
+private:
+    const WordStore *store; // Shared record store that record IDs refer to
+
+    // Frozen automaton in flat arrays (state 0 is the start state)
+    std::vector<uint32_t> stateFirstEdge; // Edges of state s are [stateFirstEdge[s], stateFirstEdge[s + 1])
+    std::vector<uint8_t> stateFinal;      // 1 if state s accepts
+    std::vector<unsigned char> edgeLabel; // Edge characters, sorted within each state
+    std::vector<uint32_t> edgeTarget;     // Target state of each edge
+    std::vector<uint32_t> edgeSkip;       // Keys ranked before any key that takes this edge
+    std::vector<WordId> rankToRecord;     // Key rank (lexicographic order) -> record ID
+
+    // === PRIVATE HELPER FUNCTIONS ===
+
+    /**
+     * Follows the edge for a character out of a state
+     * @param state: Current state
+     * @param c: Lowercase character
+     * @param rank: Increased by the edge's skip value when the edge exists
+     * @return: Target state, or -1 if there is no such edge
+     */
+    long long step(uint32_t state, unsigned char c, uint32_t &rank) const;
+
+public:
+    // === CONSTRUCTOR ===
+
+    /**
+     * Constructor
+     * @param store: Record store holding the words (must outlive the DAWG)
+     */
+    Dawg(const WordStore &store);
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Builds the minimized automaton from every record in the WordStore
+     * Keys are lowercased and sorted once, then added with incremental
+     * minimization for sorted input (Daciuk et al.); duplicates keep the
+     * highest record ID, matching Trie's "last insert wins"
+     */
+    void build();
+
+    /**
+     * Searches for a word (case-insensitive, like Trie::search)
+     * @param name: Word to search for
+     * @return: Pointer to the Word record if found, nullptr otherwise
+     */
+    const Word *search(const std::string &name) const;
+
+    /**
+     * Streams every word starting with a prefix in lexicographic order
+     * @param prefix: Prefix to match (case-insensitive)
+     * @param limit: Maximum number of results (negative = unlimited)
+     * @param callback: Called once per matching record
+     * @return: Number of results delivered
+     */
+    int forEachWithPrefix(const std::string &prefix, int limit,
+                          const std::function<void(const Word &)> &callback) const;
+
+    // === PERFORMANCE METRICS ===
+
+    /**
+     * Searches for a word and measures execution time
+     * @param name: Word to search for
+     * @param result: Reference parameter to store search result
+     * @return: Search time in nanoseconds
+     */
+    long long searchWithTiming(const std::string &name, const Word *&result);
+
+    /**
+     * Gets the memory used by the automaton and the rank table
+     * @return: Memory used in bytes
+     */
+    long long getMemoryUsage() const;
+
+    /**
+     * Gets the number of states (the DAWG's "nodes")
+     * @return: State count
+     */
+    int getNodeCount() const;
+
+    /**
+     * Gets the number of edges
+     * @return: Edge count
+     */
+    int getEdgeCount() const;
+
+    /**
+     * Gets the number of distinct (lowercased) keys
+     * @return: Key count
+     */
+    int getKeyCount() const;
+};
+
+#endif
@@ -0,0 +1,261 @@
+#include "DelimiterScanner.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DELIMITER_SCANNER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// =========================================
+// BLOCK CLASSIFIERS
+// =========================================
+
+/**
+ * Scalar classifier, used on CPUs without SSE2 (and on non-x86 CPUs)
+ * @param block: 64 bytes of text
+ * @return: Bitmask with bit i set if block[i] is '|' or '\n'
+ */
+static uint64_t scanBlockScalar(const char *block)
+{
+    uint64_t bits = 0;
+    for (int i = 0; i < 64; i++)
+    {
+        if (block[i] == '|' || block[i] == '\n')
+        {
+            bits |= uint64_t(1) << i;
+        }
+    }
+    return bits;
+}
+
+#ifdef DELIMITER_SCANNER_X86
+
+/**
+ * SSE2 classifier: four 16-byte compares against '|' and '\n'
+ * Compiled for SSE2 even when the rest of the program isn't (32-bit builds),
+ * and only selected if the CPU has it
+ * @param block: 64 bytes of text
+ * @return: Bitmask with bit i set if block[i] is '|' or '\n'
+ */
+#if defined(__GNUC__)
+__attribute__((target("sse2")))
+#endif
+static uint64_t
+scanBlockSSE2(const char *block)
+{
+    const __m128i pipe = _mm_set1_epi8('|');
+    const __m128i newline = _mm_set1_epi8('\n');
+    uint64_t bits = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i * 16));
+        __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(bytes, pipe), _mm_cmpeq_epi8(bytes, newline));
+        bits |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(matches))) << (i * 16);
+    }
+    return bits;
+}
+
+/**
+ * AVX2 classifier: two 32-byte compares against '|' and '\n'
+ * @param block: 64 bytes of text
+ * @return: Bitmask with bit i set if block[i] is '|' or '\n'
+ */
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+#endif
+static uint64_t
+scanBlockAVX2(const char *block)
+{
+    const __m256i pipe = _mm256_set1_epi8('|');
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+    __m256i lowMatches = _mm256_or_si256(_mm256_cmpeq_epi8(low, pipe), _mm256_cmpeq_epi8(low, newline));
+    __m256i highMatches = _mm256_or_si256(_mm256_cmpeq_epi8(high, pipe), _mm256_cmpeq_epi8(high, newline));
+
+    uint64_t lowBits = static_cast<uint32_t>(_mm256_movemask_epi8(lowMatches));
+    uint64_t highBits = static_cast<uint32_t>(_mm256_movemask_epi8(highMatches));
+    return lowBits | (highBits << 32);
+}
+
+/**
+ * Checks whether the CPU supports SSE2
+ * @return: True if SSE2 instructions can be used
+ */
+static bool cpuSupportsSSE2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true; // Part of the x86-64 baseline
+#elif defined(__GNUC__)
+    return __builtin_cpu_supports("sse2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Checks whether the CPU and OS support AVX2
+ * @return: True if AVX2 instructions can be used
+ */
+static bool cpuSupportsAVX2()
+{
+#if defined(__GNUC__)
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+
+    // OS must save YMM registers (OSXSAVE + XCR0 bits 1 and 2)
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif
+
+/**
+ * Picks the fastest block classifier for this CPU (evaluated once):
+ * AVX2, then SSE2, then the scalar loop
+ * @return: Selected classifier
+ */
+static DelimiterScanner::BlockScanFunction selectBlockScan()
+{
+    static const DelimiterScanner::BlockScanFunction selected = []()
+    {
+#ifdef DELIMITER_SCANNER_X86
+        if (cpuSupportsAVX2())
+        {
+            return scanBlockAVX2;
+        }
+        if (cpuSupportsSSE2())
+        {
+            return scanBlockSSE2;
+        }
+#endif
+        return scanBlockScalar;
+    }();
+    return selected;
+}
+
+// =========================================
+// DELIMITERSCANNER IMPLEMENTATION
+// =========================================
+
+/**
+ * DelimiterScanner Constructor
+ * Classifies the first block right away
+ * @param data: Text to scan
+ * @param length: Length of the text in bytes
+ */
+DelimiterScanner::DelimiterScanner(const char *data, size_t length)
+    : data(data), length(length), blockStart(0), mask(0), scanBlock(selectBlockScan())
+{
+    loadBlock(0);
+}
+
+/**
+ * Classifies the 64-byte block starting at a given offset
+ * Full blocks use the selected classifier; the final partial block is classified
+ * byte by byte so nothing past the end of the text is ever read
+ * @param start: Offset of the block (a multiple of 64)
+ * @return: False once the end of the text has been reached
+ */
+bool DelimiterScanner::loadBlock(size_t start)
+{
+    blockStart = start;
+    if (blockStart >= length)
+    {
+        mask = 0;
+        return false;
+    }
+
+    if (length - blockStart >= 64)
+    {
+        mask = scanBlock(data + blockStart);
+    }
+    else
+    {
+        mask = 0;
+        for (size_t i = 0; blockStart + i < length; i++)
+        {
+            char c = data[blockStart + i];
+            if (c == '|' || c == '\n')
+            {
+                mask |= uint64_t(1) << i;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns the position of the next '|' or '\n'
+ * Skips blocks without delimiters, then pops the lowest set bit of the mask
+ * @return: Offset of the delimiter, or the text length if there are no more
+ */
+size_t DelimiterScanner::next()
+{
+    while (mask == 0)
+    {
+        if (!loadBlock(blockStart + 64))
+        {
+            return length;
+        }
+    }
+
+#if defined(__GNUC__)
+    unsigned offset = static_cast<unsigned>(__builtin_ctzll(mask));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long offset;
+    _BitScanForward64(&offset, mask);
+#else
+    unsigned offset = 0;
+    while (((mask >> offset) & 1) == 0)
+    {
+        offset++;
+    }
+#endif
+
+    mask &= mask - 1; // Clear the delimiter just returned
+    return blockStart + offset;
+}
+
+/**
+ * Returns the name of the block classifier selected for this CPU
+ * @return: "AVX2", "SSE2" or "scalar"
+ */
+const char *DelimiterScanner::getImplementationName()
+{
+#ifdef DELIMITER_SCANNER_X86
+    if (selectBlockScan() == scanBlockAVX2)
+    {
+        return "AVX2";
+    }
+    if (selectBlockScan() == scanBlockSSE2)
+    {
+        return "SSE2";
+    }
+#endif
+    return "scalar";
+}
@@ -0,0 +1,60 @@
+#ifndef DELIMITERSCANNER_H
+#define DELIMITERSCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * DelimiterScanner - Finds '|' and '\n' positions in dictionary text
+ * Classifies 64 bytes at a time into a bitmask of delimiter positions, then
+ * hands the positions out one by one with a count-trailing-zeros per delimiter
+ * The block classifier is picked once at runtime from the CPU's features:
+ * AVX2 (2 x 32-byte compares), SSE2 (4 x 16-byte compares) or a scalar fallback
+ */
+class DelimiterScanner
+{
+public:
+    typedef uint64_t (*BlockScanFunction)(const char *block); // Classifies 64 bytes
+
+private:
+    const char *data;         // Text being scanned
+    size_t length;            // Length of the text in bytes
+    size_t blockStart;        // Offset of the 64-byte block the mask describes
+    uint64_t mask;            // Bit i set = delimiter at blockStart + i (not yet returned)
+    BlockScanFunction scanBlock; // Selected block classifier
+
+    /**
+     * Classifies the block at an offset (or the short tail with scalar code)
+     * @param start: Offset of the block (a multiple of 64)
+     * @return: False once the end of the text has been reached
+     */
+    bool loadBlock(size_t start);
+
+public:
+    // === CONSTRUCTOR ===
+
+    /**
+     * Constructor
+     * @param data: Text to scan
+     * @param length: Length of the text in bytes
+     */
+    DelimiterScanner(const char *data, size_t length);
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Returns the position of the next '|' or '\n'
+     * @return: Offset of the delimiter, or the text length if there are no more
+     */
+    size_t next();
+
+    // === CPU DISPATCH ===
+
+    /**
+     * Gets the name of the block classifier selected for this CPU
+     * @return: "AVX2", "SSE2" or "scalar"
+     */
+    static const char *getImplementationName();
+};
+
+#endif
@@ -0,0 +1,452 @@
+#include "DoubleArrayTrie.h"
+#include "Trie.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+// =========================================
+// CONSTRUCTORS
+// =========================================
+
+/**
+ * Constructor for an empty double-array trie
+ * @param store: Record store holding the words (must outlive the trie)
+ */
+DoubleArrayTrie::DoubleArrayTrie(const WordStore &store)
+    : store(&store), units(nullptr), values(nullptr), firstChild(nullptr), nextSibling(nullptr),
+      cellCount(0), stateCount(0)
+{
+}
+
+/**
+ * Constructor - Lays out a built Trie in BASE/CHECK form
+ * Nodes are placed breadth-first; for each node the smallest base is chosen
+ * whose child cells are all free, found by walking a doubly-linked list of
+ * free cells. The array keeps 256 spare cells past the highest base, so
+ * base + code never needs a bounds check
+ * @param store: Record store holding the words (must outlive the trie)
+ * @param trie: Trie to freeze (only read)
+ */
+DoubleArrayTrie::DoubleArrayTrie(const WordStore &store, const Trie &trie)
+    : DoubleArrayTrie(store)
+{
+    // Free-cell list (prev/next indices, -1 terminates)
+    std::vector<int32_t> nextFree;
+    std::vector<int32_t> prevFree;
+    int32_t freeHead = -1;
+    int32_t freeTail = -1;
+
+    auto grow = [&](size_t needed)
+    {
+        size_t oldSize = unitStorage.size();
+        if (needed <= oldSize)
+        {
+            return;
+        }
+        size_t newSize = oldSize == 0 ? 1024 : oldSize;
+        while (newSize < needed)
+        {
+            newSize *= 2;
+        }
+
+        unitStorage.resize(newSize, DoubleArrayUnit{0, -1});
+        valueStorage.resize(newSize, WordStore::INVALID_ID);
+        firstChildStorage.resize(newSize, 0);
+        nextSiblingStorage.resize(newSize, 0);
+        nextFree.resize(newSize, -1);
+        prevFree.resize(newSize, -1);
+
+        for (size_t i = oldSize; i < newSize; i++)
+        {
+            int32_t cell = static_cast<int32_t>(i);
+            prevFree[i] = freeTail;
+            if (freeTail >= 0)
+            {
+                nextFree[freeTail] = cell;
+            }
+            else
+            {
+                freeHead = cell;
+            }
+            freeTail = cell;
+        }
+    };
+
+    auto take = [&](int32_t cell, int32_t parent)
+    {
+        if (prevFree[cell] >= 0)
+        {
+            nextFree[prevFree[cell]] = nextFree[cell];
+        }
+        else
+        {
+            freeHead = nextFree[cell];
+        }
+        if (nextFree[cell] >= 0)
+        {
+            prevFree[nextFree[cell]] = prevFree[cell];
+        }
+        else
+        {
+            freeTail = prevFree[cell];
+        }
+        unitStorage[cell].check = parent;
+        stateCount++;
+    };
+
+    grow(257);
+    take(0, 0); // The root's check is never matched: no base + code reaches cell 0
+    stateCount = 0; // Like Trie::getNodeCount, the root is not counted
+    const TrieNode &root = trie.getNode(trie.getRoot());
+    valueStorage[0] = root.isEndOfWord ? root.wordId : WordStore::INVALID_ID;
+
+    std::vector<std::pair<NodeIndex, int32_t>> queue;
+    queue.emplace_back(trie.getRoot(), 0);
+    std::vector<int> codes;
+    std::vector<NodeIndex> children;
+    int32_t highestBase = 0;
+
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        NodeIndex node = queue[head].first;
+        int32_t state = queue[head].second;
+
+        codes.clear();
+        children.clear();
+        for (int slot = 0; slot < trie.getNode(node).getSlotCount(); slot++)
+        {
+            char key;
+            NodeIndex child = trie.getChildAt(node, slot, key);
+            if (child != NULL_NODE)
+            {
+                codes.push_back(codeOf(key));
+                children.push_back(child);
+            }
+        }
+        if (codes.empty())
+        {
+            continue; // Leaf: base stays 0 and no cell is ever checked against it
+        }
+
+        // Smallest base whose child cells are all free (the first child lands on a free cell)
+        int32_t base = 0;
+        for (int32_t cell = freeHead;; cell = nextFree[cell])
+        {
+            if (cell < 0)
+            {
+                cell = static_cast<int32_t>(unitStorage.size());
+                grow(unitStorage.size() + 1);
+            }
+            base = cell - codes[0];
+            if (base < 0)
+            {
+                continue;
+            }
+            grow(static_cast<size_t>(base) + 257);
+
+            bool fits = true;
+            for (size_t i = 1; i < codes.size() && fits; i++)
+            {
+                fits = unitStorage[base + codes[i]].check < 0;
+            }
+            if (fits)
+            {
+                break;
+            }
+        }
+
+        unitStorage[state].base = base;
+        firstChildStorage[state] = static_cast<uint16_t>(codes[0]);
+        if (base > highestBase)
+        {
+            highestBase = base;
+        }
+
+        for (size_t i = 0; i < codes.size(); i++)
+        {
+            int32_t cell = base + codes[i];
+            take(cell, state);
+            const TrieNode &childNode = trie.getNode(children[i]);
+            valueStorage[cell] = childNode.isEndOfWord ? childNode.wordId : WordStore::INVALID_ID;
+            nextSiblingStorage[cell] = static_cast<uint16_t>(i + 1 < codes.size() ? codes[i + 1] : 0);
+            queue.emplace_back(children[i], cell);
+        }
+    }
+
+    // Trim the unused tail, keeping 256 spare cells past the highest base
+    size_t used = unitStorage.size();
+    while (used > 0 && unitStorage[used - 1].check < 0)
+    {
+        used--;
+    }
+    size_t length = std::max(used, static_cast<size_t>(highestBase) + 257);
+    unitStorage.resize(length);
+    valueStorage.resize(length);
+    firstChildStorage.resize(length);
+    nextSiblingStorage.resize(length);
+    unitStorage.shrink_to_fit();
+    valueStorage.shrink_to_fit();
+    firstChildStorage.shrink_to_fit();
+    nextSiblingStorage.shrink_to_fit();
+    attachStorage();
+}
+
+/**
+ * Points the read views at the owned arrays (after building)
+ */
+void DoubleArrayTrie::attachStorage()
+{
+    units = unitStorage.data();
+    values = valueStorage.data();
+    firstChild = firstChildStorage.data();
+    nextSibling = nextSiblingStorage.data();
+    cellCount = unitStorage.size();
+}
+
+// =========================================
+// SEARCH OPERATIONS
+// =========================================
+
+/**
+ * Maps a character to its transition code (1..256, preserving byte order)
+ * @param c: Character (lowercased by the caller)
+ * @return: Transition code
+ */
+int DoubleArrayTrie::codeOf(char c)
+{
+    return static_cast<unsigned char>(c) + 1;
+}
+
+/**
+ * Walks the transitions of a string from the root
+ * Each step is base[s] + code followed by one check comparison
+ * @param text: Characters to follow (lowercased on the fly)
+ * @return: Reached state, or -1 if a transition is missing
+ */
+int DoubleArrayTrie::walk(const std::string &text) const
+{
+    if (cellCount == 0)
+    {
+        return -1;
+    }
+
+    int32_t state = 0;
+    for (char c : text)
+    {
+        int32_t next = units[state].base + codeOf(tolower(c));
+        if (units[next].check != state)
+        {
+            return -1;
+        }
+        state = next;
+    }
+    return state;
+}
+
+/**
+ * Searches for a word (case-insensitive)
+ * @param name: Word to search for
+ * @return: Pointer to the Word record if found, nullptr otherwise
+ */
+const Word *DoubleArrayTrie::search(const std::string &name) const
+{
+    int state = walk(name);
+    if (state < 0 || values[state] == WordStore::INVALID_ID)
+    {
+        return nullptr;
+    }
+    return &store->get(values[state]);
+}
+
+/**
+ * Streams every word starting with a prefix in lexicographic order
+ * Depth-first over the sibling links with an explicit stack; a word is
+ * reported before the longer words that extend it
+ * @param prefix: Prefix to match (case-insensitive)
+ * @param limit: Maximum number of results (negative = unlimited)
+ * @param callback: Called once per matching record
+ * @return: Number of results delivered
+ */
+int DoubleArrayTrie::forEachWithPrefix(const std::string &prefix, int limit,
+                                       const std::function<void(const Word &)> &callback) const
+{
+    int start = walk(prefix);
+    if (start < 0 || limit == 0)
+    {
+        return 0;
+    }
+
+    int delivered = 0;
+    std::vector<int32_t> stack(1, start);
+    std::vector<int32_t> children;
+
+    while (!stack.empty())
+    {
+        int32_t state = stack.back();
+        stack.pop_back();
+
+        if (values[state] != WordStore::INVALID_ID)
+        {
+            callback(store->get(values[state]));
+            delivered++;
+            if (delivered == limit)
+            {
+                break;
+            }
+        }
+
+        // Push children in reverse so the smallest character is visited first
+        children.clear();
+        for (int code = firstChild[state]; code != 0;)
+        {
+            int32_t child = units[state].base + code;
+            children.push_back(child);
+            code = nextSibling[child];
+        }
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    return delivered;
+}
+
+// =========================================
+// SNAPSHOT
+// =========================================
+
+/**
+ * Adds the four cell arrays to a snapshot; param0 = state count
+ * @param writer: Snapshot being assembled
+ */
+void DoubleArrayTrie::writeSnapshot(SnapshotWriter &writer) const
+{
+    writer.addSection(SnapshotSection::FROZEN_UNITS, units, cellCount * sizeof(DoubleArrayUnit), cellCount,
+                      static_cast<uint64_t>(stateCount));
+    writer.addSection(SnapshotSection::FROZEN_VALUES, values, cellCount * sizeof(WordId), cellCount);
+    writer.addSection(SnapshotSection::FROZEN_FIRST_CHILD, firstChild, cellCount * sizeof(uint16_t), cellCount);
+    writer.addSection(SnapshotSection::FROZEN_NEXT_SIBLING, nextSibling, cellCount * sizeof(uint16_t), cellCount);
+}
+
+/**
+ * Serves lookups straight from a snapshot's cell arrays; owned arrays are released
+ * @param reader: Validated snapshot, already attached to the WordStore
+ * @return: False if a section is missing or the arrays are inconsistent
+ */
+bool DoubleArrayTrie::readSnapshot(const SnapshotReader &reader)
+{
+    if (!checkSnapshot(reader, static_cast<uint32_t>(store->size())))
+    {
+        return false;
+    }
+
+    const SnapshotSectionEntry *unitSection = reader.find(SnapshotSection::FROZEN_UNITS);
+    units = reinterpret_cast<const DoubleArrayUnit *>(reader.data(*unitSection));
+    values = reinterpret_cast<const WordId *>(reader.data(*reader.find(SnapshotSection::FROZEN_VALUES)));
+    firstChild = reinterpret_cast<const uint16_t *>(reader.data(*reader.find(SnapshotSection::FROZEN_FIRST_CHILD)));
+    nextSibling = reinterpret_cast<const uint16_t *>(reader.data(*reader.find(SnapshotSection::FROZEN_NEXT_SIBLING)));
+    cellCount = unitSection->count;
+    stateCount = static_cast<int>(unitSection->param0);
+
+    std::vector<DoubleArrayUnit>().swap(unitStorage);
+    std::vector<WordId>().swap(valueStorage);
+    std::vector<uint16_t>().swap(firstChildStorage);
+    std::vector<uint16_t>().swap(nextSiblingStorage);
+    return true;
+}
+
+/**
+ * Checks the four cell sections before anything uses them
+ * The reader has already checked each section's bounds; this checks that the four
+ * arrays agree in length, that the 256 spare cells are present so base + code stays
+ * in range for any base stored in the file, that every stored code is a real code
+ * and that every record ID is inside the store
+ * @param reader: Validated snapshot
+ * @param recordCount: Number of records in the snapshot's WordStore
+ * @return: True if readSnapshot() would accept them
+ */
+bool DoubleArrayTrie::checkSnapshot(const SnapshotReader &reader, uint32_t recordCount)
+{
+    const SnapshotSectionEntry *unitSection = reader.find(SnapshotSection::FROZEN_UNITS);
+    const SnapshotSectionEntry *valueSection = reader.find(SnapshotSection::FROZEN_VALUES);
+    const SnapshotSectionEntry *firstSection = reader.find(SnapshotSection::FROZEN_FIRST_CHILD);
+    const SnapshotSectionEntry *siblingSection = reader.find(SnapshotSection::FROZEN_NEXT_SIBLING);
+    if (unitSection == nullptr || valueSection == nullptr || firstSection == nullptr || siblingSection == nullptr)
+    {
+        return false;
+    }
+
+    uint32_t count = unitSection->count;
+    if (count < 257 || valueSection->count != count || firstSection->count != count ||
+        siblingSection->count != count)
+    {
+        return false;
+    }
+
+    const DoubleArrayUnit *mappedUnits = reinterpret_cast<const DoubleArrayUnit *>(reader.data(*unitSection));
+    const WordId *mappedValues = reinterpret_cast<const WordId *>(reader.data(*valueSection));
+    const uint16_t *mappedFirst = reinterpret_cast<const uint16_t *>(reader.data(*firstSection));
+    const uint16_t *mappedSibling = reinterpret_cast<const uint16_t *>(reader.data(*siblingSection));
+    for (uint32_t cell = 0; cell < count; cell++)
+    {
+        if (mappedUnits[cell].base < 0 || static_cast<uint64_t>(mappedUnits[cell].base) + 257 > count ||
+            mappedFirst[cell] > 256 || mappedSibling[cell] > 256 ||
+            (mappedValues[cell] != WordStore::INVALID_ID && mappedValues[cell] >= recordCount))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =========================================
+// PERFORMANCE MEASUREMENT
+// =========================================
+
+/**
+ * Searches for a word and measures execution time
+ * @param name: Word to search for
+ * @param result: Reference parameter to store search result
+ * @return: Search time in nanoseconds
+ */
+long long DoubleArrayTrie::searchWithTiming(const std::string &name, const Word *&result) const
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    result = search(name);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// =========================================
+// MEMORY USAGE CALCULATION
+// =========================================
+
+/**
+ * Calculates the memory used by the arrays (free cells included)
+ * @return: Memory used in bytes
+ */
+long long DoubleArrayTrie::getMemoryUsage() const
+{
+    return static_cast<long long>(cellCount * (sizeof(DoubleArrayUnit) + sizeof(WordId) + 2 * sizeof(uint16_t)));
+}
+
+// =========================================
+// GETTERS
+// =========================================
+
+/**
+ * Gets the number of states
+ * @return: State count
+ */
+int DoubleArrayTrie::getNodeCount() const
+{
+    return stateCount;
+}
+
+/**
+ * Gets the array length including free cells
+ * @return: Cell count
+ */
+int DoubleArrayTrie::getCellCount() const
+{
+    return static_cast<int>(cellCount);
+}
@@ -0,0 +1,162 @@
+#ifndef DOUBLEARRAYTRIE_H
+#define DOUBLEARRAYTRIE_H
+
+#include "WordStore.h"
+#include "Snapshot.h"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Trie;
+
+/**
+ * DoubleArrayTrie - Read-only, pointer-free form of a built Trie
+ * Every state is a cell in one array; the transition on character c from
+ * state s goes to t = base[s] + code(c) and exists only if check[t] == s,
+ * so each character costs two array reads with no hashing and no pointers
+ * Produced by Trie::freeze(); the mutable Trie stays available for building
+ * Time Complexity: O(m) search, m = word length
+ */
+class DoubleArrayTrie
+{
+public:
+    /**
+     * DoubleArrayUnit - Hot part of a cell, read on every transition
+     */
+    struct DoubleArrayUnit
+    {
+        int32_t base;  // Offset of this state's children (0 for leaves)
+        int32_t check; // Parent state of this cell, -1 if the cell is free
+    };
+
+private:
+    const WordStore *store; // Shared record store that record IDs refer to
+
+    std::vector<DoubleArrayUnit> unitStorage; // Owned arrays when built from a Trie (empty when
+    std::vector<WordId> valueStorage;         // the views below point into a snapshot)
+    std::vector<uint16_t> firstChildStorage;
+    std::vector<uint16_t> nextSiblingStorage;
+
+    const DoubleArrayUnit *units; // BASE/CHECK pairs; cell 0 is the root
+    const WordId *values;         // Record ID per cell, INVALID_ID if not the end of a word
+    const uint16_t *firstChild;   // Code of the first child (0 = none), for ordered enumeration
+    const uint16_t *nextSibling;  // Code of the next sibling under the same parent (0 = none)
+    size_t cellCount;             // Length of each array
+    int stateCount;               // Cells in use, root excluded
+
+    // === PRIVATE HELPER FUNCTIONS ===
+
+    /**
+     * Maps a character to its transition code (1..256, preserving byte order)
+     * @param c: Character (lowercased by the caller)
+     * @return: Transition code
+     */
+    static int codeOf(char c);
+
+    /**
+     * Walks the transitions of a string from the root
+     * @param text: Characters to follow (lowercased on the fly)
+     * @return: Reached state, or -1 if a transition is missing
+     */
+    int walk(const std::string &text) const;
+
+    /**
+     * Points the read views at the owned arrays (after building)
+     */
+    void attachStorage();
+
+public:
+    // === CONSTRUCTORS ===
+
+    /**
+     * Constructor for an empty double-array trie
+     * @param store: Record store holding the words (must outlive the trie)
+     */
+    DoubleArrayTrie(const WordStore &store);
+
+    /**
+     * Constructor - Lays out a built Trie in BASE/CHECK form
+     * @param store: Record store holding the words (must outlive the trie)
+     * @param trie: Trie to freeze (only read)
+     */
+    DoubleArrayTrie(const WordStore &store, const Trie &trie);
+
+    // Views point into the owned arrays, whose buffers survive a move but not a copy
+    DoubleArrayTrie(const DoubleArrayTrie &) = delete;
+    DoubleArrayTrie &operator=(const DoubleArrayTrie &) = delete;
+    DoubleArrayTrie(DoubleArrayTrie &&) = default;
+    DoubleArrayTrie &operator=(DoubleArrayTrie &&) = default;
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Searches for a word (case-insensitive, like Trie::search)
+     * @param name: Word to search for
+     * @return: Pointer to the Word record if found, nullptr otherwise
+     */
+    const Word *search(const std::string &name) const;
+
+    /**
+     * Streams every word starting with a prefix in lexicographic order
+     * @param prefix: Prefix to match (case-insensitive)
+     * @param limit: Maximum number of results (negative = unlimited)
+     * @param callback: Called once per matching record
+     * @return: Number of results delivered
+     */
+    int forEachWithPrefix(const std::string &prefix, int limit,
+                          const std::function<void(const Word &)> &callback) const;
+
+    // === SNAPSHOT ===
+
+    /**
+     * Adds the cell arrays to a snapshot
+     * @param writer: Snapshot being assembled
+     */
+    void writeSnapshot(SnapshotWriter &writer) const;
+
+    /**
+     * Serves lookups from a snapshot's cell arrays in place
+     * @param reader: Validated snapshot, already attached to the WordStore
+     * @return: False if a section is missing or inconsistent
+     */
+    bool readSnapshot(const SnapshotReader &reader);
+
+    /**
+     * Checks the cell sections without adopting them
+     * @param reader: Validated snapshot
+     * @param recordCount: Number of records in the snapshot's WordStore
+     * @return: True if readSnapshot() would accept them
+     */
+    static bool checkSnapshot(const SnapshotReader &reader, uint32_t recordCount);
+
+    // === PERFORMANCE METRICS ===
+
+    /**
+     * Searches for a word and measures execution time
+     * @param name: Word to search for
+     * @param result: Reference parameter to store search result
+     * @return: Search time in nanoseconds
+     */
+    long long searchWithTiming(const std::string &name, const Word *&result) const;
+
+    /**
+     * Gets the memory used by the arrays (including free cells)
+     * @return: Memory used in bytes
+     */
+    long long getMemoryUsage() const;
+
+    /**
+     * Gets the number of states (one per Trie node)
+     * @return: State count
+     */
+    int getNodeCount() const;
+
+    /**
+     * Gets the array length including free cells
+     * @return: Cell count
+     */
+    int getCellCount() const;
+};
+
+#endif
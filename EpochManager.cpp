@@ -0,0 +1,130 @@
+#include "EpochManager.h"
+
+// =========================================
+// CONSTRUCTOR
+// =========================================
+
+/**
+ * Constructor
+ * Every slot starts free and quiescent; epoch 0 is reserved for QUIESCENT
+ */
+EpochManager::EpochManager()
+    : globalEpoch(1)
+{
+    for (ReaderSlot &slot : readers)
+    {
+        slot.epoch.store(QUIESCENT, std::memory_order_relaxed);
+        slot.inUse.store(false, std::memory_order_relaxed);
+    }
+}
+
+// =========================================
+// READERS
+// =========================================
+
+/**
+ * Claims the first free reader slot with a compare-and-swap (never blocks)
+ * @return: Reader ID, or -1 if all MAX_READERS slots are taken
+ */
+int EpochManager::registerReader()
+{
+    for (int i = 0; i < MAX_READERS; i++)
+    {
+        bool expected = false;
+        if (readers[i].inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Releases a reader slot so another thread can claim it
+ * @param reader: ID returned by registerReader()
+ */
+void EpochManager::unregisterReader(int reader)
+{
+    readers[reader].epoch.store(QUIESCENT, std::memory_order_release);
+    readers[reader].inUse.store(false, std::memory_order_release);
+}
+
+/**
+ * Announces the current epoch before the reader loads any root
+ * The announcement is sequentially consistent: a writer that does not see it
+ * has already published its new root, so this reader can only reach the new
+ * version and never the objects that writer is about to reuse
+ * @param reader: ID returned by registerReader()
+ */
+void EpochManager::enter(int reader)
+{
+    readers[reader].epoch.store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+}
+
+/**
+ * Marks the reader quiescent; its reads are ordered before the store
+ * @param reader: ID returned by registerReader()
+ */
+void EpochManager::exit(int reader)
+{
+    readers[reader].epoch.store(QUIESCENT, std::memory_order_release);
+}
+
+// =========================================
+// WRITERS
+// =========================================
+
+/**
+ * Returns the current epoch and advances it, so readers entering from now on
+ * announce an epoch newer than anything retired so far
+ * @return: Epoch to store with the unlinked objects
+ */
+uint64_t EpochManager::retireEpoch()
+{
+    return globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+}
+
+/**
+ * Scans the reader slots for the oldest announced epoch
+ * @return: Smallest epoch of a reader inside a guard, or the current epoch
+ */
+uint64_t EpochManager::getSafeEpoch() const
+{
+    uint64_t safe = globalEpoch.load(std::memory_order_seq_cst);
+    for (const ReaderSlot &slot : readers)
+    {
+        if (!slot.inUse.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+        uint64_t announced = slot.epoch.load(std::memory_order_seq_cst);
+        if (announced != QUIESCENT && announced < safe)
+        {
+            safe = announced;
+        }
+    }
+    return safe;
+}
+
+// =========================================
+// EPOCHGUARD IMPLEMENTATION
+// =========================================
+
+/**
+ * Constructor - enters the current epoch
+ * @param epochs: Manager the reader is registered with
+ * @param reader: ID returned by registerReader()
+ */
+EpochGuard::EpochGuard(EpochManager &epochs, int reader)
+    : epochs(epochs), reader(reader)
+{
+    epochs.enter(reader);
+}
+
+/**
+ * Destructor - leaves the epoch
+ */
+EpochGuard::~EpochGuard()
+{
+    epochs.exit(reader);
+}
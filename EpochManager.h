@@ -0,0 +1,119 @@
+#ifndef EPOCHMANAGER_H
+#define EPOCHMANAGER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * EpochManager - Epoch-based reclamation for structures read without locks
+ * Readers announce the global epoch while they hold references into a structure;
+ * writers unlink old nodes, tag them with retireEpoch() and reuse them only once
+ * the tag is older than every active reader's epoch (getSafeEpoch())
+ * Readers never block: entering and leaving is one store to the reader's own
+ * cache line. Writers never wait for readers either; nodes that are still
+ * visible simply stay retired until a later write finds them reclaimable
+ * Each reading thread registers once and holds an EpochGuard per operation
+ */
+class EpochManager
+{
+public:
+    static const int MAX_READERS = 128; // Reader threads that can be registered at once
+
+private:
+    /**
+     * ReaderSlot - Announcement of one reader thread, alone on its cache line
+     */
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<uint64_t> epoch; // Epoch announced on entry, QUIESCENT outside a guard
+        std::atomic<bool> inUse;     // Claimed by a registered reader
+    };
+
+    static const uint64_t QUIESCENT = 0; // Announced epoch of a reader outside any guard
+
+    ReaderSlot readers[MAX_READERS];
+    std::atomic<uint64_t> globalEpoch; // Current epoch (starts at 1)
+
+public:
+    // === CONSTRUCTOR ===
+
+    /**
+     * Constructor - no readers registered, epoch 1
+     */
+    EpochManager();
+
+    EpochManager(const EpochManager &) = delete;
+    EpochManager &operator=(const EpochManager &) = delete;
+
+    // === READERS ===
+
+    /**
+     * Claims a reader slot for the calling thread (lock-free)
+     * @return: Reader ID to pass to EpochGuard, or -1 if all slots are taken
+     */
+    int registerReader();
+
+    /**
+     * Releases a reader slot; the reader must be outside any guard
+     * @param reader: ID returned by registerReader()
+     */
+    void unregisterReader(int reader);
+
+    /**
+     * Announces that a reader is about to follow references into a structure
+     * @param reader: ID returned by registerReader()
+     */
+    void enter(int reader);
+
+    /**
+     * Announces that a reader holds no more references
+     * @param reader: ID returned by registerReader()
+     */
+    void exit(int reader);
+
+    // === WRITERS ===
+
+    /**
+     * Tags objects a writer has just unlinked and starts a new epoch
+     * Call after the new version has been published
+     * @return: Epoch to store with the unlinked objects
+     */
+    uint64_t retireEpoch();
+
+    /**
+     * Gets the oldest epoch an active reader may still be in
+     * Objects retired in an earlier epoch are unreachable and can be reused
+     * @return: Smallest announced epoch, or the current epoch if no reader is inside a guard
+     */
+    uint64_t getSafeEpoch() const;
+};
+
+/**
+ * EpochGuard - Keeps a reader inside an epoch for the guard's lifetime
+ * Every node, record pointer or iterator obtained inside the guard stays
+ * valid until the guard is destroyed
+ */
+class EpochGuard
+{
+private:
+    EpochManager &epochs; // Manager the reader is registered with
+    int reader;           // Reader ID
+
+public:
+    /**
+     * Constructor - enters the current epoch
+     * @param epochs: Manager the reader is registered with
+     * @param reader: ID returned by registerReader()
+     */
+    EpochGuard(EpochManager &epochs, int reader);
+
+    /**
+     * Destructor - leaves the epoch
+     */
+    ~EpochGuard();
+
+    EpochGuard(const EpochGuard &) = delete;
+    EpochGuard &operator=(const EpochGuard &) = delete;
+};
+
+#endif
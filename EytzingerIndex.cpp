@@ -0,0 +1,349 @@
+#include "EytzingerIndex.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// =========================================
+// ITERATOR IMPLEMENTATION
+// =========================================
+
+/**
+ * Iterator constructor
+ * @param index: Index being walked
+ * @param rank: Position in sorted order (getKeyCount() = end)
+ */
+EytzingerIndex::Iterator::Iterator(const EytzingerIndex *index, size_t rank)
+    : index(index), rank(rank)
+{
+}
+
+/**
+ * Returns the current word
+ * @return: Reference to the record in the WordStore
+ */
+const Word &EytzingerIndex::Iterator::operator*() const
+{
+    return index->store->get(index->sortedIds[rank]);
+}
+
+/**
+ * Returns the current word
+ * @return: Pointer to the record in the WordStore
+ */
+const Word *EytzingerIndex::Iterator::operator->() const
+{
+    return &**this;
+}
+
+/**
+ * Advances to the next position in sorted order
+ * @return: This iterator
+ */
+EytzingerIndex::Iterator &EytzingerIndex::Iterator::operator++()
+{
+    rank++;
+    return *this;
+}
+
+/**
+ * Compares positions
+ * @param other: Iterator over the same index
+ * @return: True if both are at the same word or both at the end
+ */
+bool EytzingerIndex::Iterator::operator==(const Iterator &other) const
+{
+    return rank == other.rank;
+}
+
+/**
+ * Compares positions
+ * @param other: Iterator over the same index
+ * @return: True if the positions differ
+ */
+bool EytzingerIndex::Iterator::operator!=(const Iterator &other) const
+{
+    return rank != other.rank;
+}
+
+// =========================================
+// CONSTRUCTION
+// =========================================
+
+/**
+ * Constructor for an empty index
+ * @param store: Record store holding the words (must outlive the index)
+ */
+EytzingerIndex::EytzingerIndex(const WordStore &store)
+    : store(&store), prefixes(nullptr), ranks(nullptr), keyCount(0)
+{
+}
+
+/**
+ * Constructor - Lays out the words of a built BinaryTree
+ * The tree's in-order walk already yields the words sorted and duplicate-free
+ * @param store: Record store holding the words (must outlive the index)
+ * @param tree: Tree to copy the ordered keys from (only read)
+ */
+EytzingerIndex::EytzingerIndex(const WordStore &store, const BinaryTree &tree)
+    : EytzingerIndex(store)
+{
+    sortedIds.reserve(static_cast<size_t>(tree.getNodeCount()));
+    for (const Word &word : tree)
+    {
+        sortedIds.push_back(store.idOf(word));
+    }
+    layOut();
+}
+
+/**
+ * Packs the first 8 bytes of a word, most significant first, zero-padded
+ * Comparing two packed prefixes as integers orders the words like comparing
+ * their first 8 bytes as unsigned characters (std::string_view::compare)
+ * @param word: Word to pack
+ * @return: Big-endian prefix
+ */
+uint64_t EytzingerIndex::prefixOf(std::string_view word)
+{
+    uint64_t prefix = 0;
+    for (size_t i = 0; i < 8; i++)
+    {
+        prefix = (prefix << 8) | (i < word.size() ? static_cast<unsigned char>(word[i]) : 0u);
+    }
+    return prefix;
+}
+
+/**
+ * Fills the Eytzinger arrays from sortedIds
+ * Visits the slots of the implicit tree in order (leftmost slot first, then
+ * in-order successors) and hands them consecutive sorted positions
+ * The prefix array is shifted so that slot 0 starts a cache line; slots
+ * 8k..8k+7 then share one line, which is what descend() prefetches
+ */
+void EytzingerIndex::layOut()
+{
+    keyCount = sortedIds.size();
+    prefixStorage.assign(keyCount + 1 + LINE_KEYS, 0);
+    rankStorage.assign(keyCount + 1, 0);
+
+    size_t misalignment = reinterpret_cast<uintptr_t>(prefixStorage.data()) % (LINE_KEYS * sizeof(uint64_t));
+    size_t offset = misalignment == 0 ? 0 : LINE_KEYS - misalignment / sizeof(uint64_t);
+    uint64_t *prefixSlots = prefixStorage.data() + offset;
+    uint32_t *rankSlots = rankStorage.data();
+
+    if (keyCount > 0)
+    {
+        // Leftmost slot holds the smallest word
+        size_t k = 1;
+        while (2 * k <= keyCount)
+        {
+            k = 2 * k;
+        }
+
+        for (size_t rank = 0; rank < keyCount; rank++)
+        {
+            prefixSlots[k] = prefixOf(store->get(sortedIds[rank]).getWord());
+            rankSlots[k] = static_cast<uint32_t>(rank);
+
+            // In-order successor: leftmost slot of the right subtree, or the first
+            // ancestor whose left subtree we are leaving
+            if (2 * k + 1 <= keyCount)
+            {
+                k = 2 * k + 1;
+                while (2 * k <= keyCount)
+                {
+                    k = 2 * k;
+                }
+            }
+            else
+            {
+                while (k & 1)
+                {
+                    k >>= 1;
+                }
+                k >>= 1;
+            }
+        }
+    }
+
+    prefixes = prefixSlots;
+    ranks = rankSlots;
+}
+
+// =========================================
+// SEARCH OPERATION
+// =========================================
+
+/**
+ * Descends the implicit tree to the first word not less than (or greater than) a key
+ * Every level is taken, whatever the comparisons say: k becomes 2k + (go right),
+ * computed from one integer compare, so there is no branch to mispredict; the
+ * word itself is only read when its 8-byte prefix equals the key's
+ * The answer is the last slot where the descent went left, recovered at the end
+ * by dropping the trailing right turns (trailing 1 bits of k) and one left turn
+ * @param key: Key to position at
+ * @param strict: True for the first word greater than the key (upper bound)
+ * @return: Sorted position of that word, or keyCount if there is none
+ */
+size_t EytzingerIndex::descend(std::string_view key, bool strict) const
+{
+    uint64_t query = prefixOf(key);
+    size_t k = 1;
+
+    while (k <= keyCount)
+    {
+        // Slots 8k..8k+7 are the descendants three levels down (prefetching past
+        // the end is harmless: the address is never dereferenced)
+        prefetchLine(prefixes + LINE_KEYS * k);
+
+        uint64_t prefix = prefixes[k];
+        size_t right = strict ? (prefix <= query) : (prefix < query);
+        if (prefix == query)
+        {
+            // Words share their first 8 bytes: compare the full words
+            int cmp = store->get(sortedIds[ranks[k]]).getWord().compare(key);
+            right = strict ? (cmp <= 0) : (cmp < 0);
+        }
+        k = 2 * k + right;
+    }
+
+#if defined(_MSC_VER)
+    unsigned long shift;
+    _BitScanForward64(&shift, ~static_cast<uint64_t>(k));
+    k >>= shift + 1;
+#else
+    k >>= __builtin_ffsll(static_cast<long long>(~static_cast<uint64_t>(k)));
+#endif
+    return (k == 0) ? keyCount : ranks[k];
+}
+
+/**
+ * Searches for a word (case-sensitive)
+ * The lower bound is the word itself if it is indexed
+ * @param name: Word to search for
+ * @return: Pointer to the Word record if found, nullptr otherwise
+ */
+const Word *EytzingerIndex::search(const std::string &name) const
+{
+    size_t rank = descend(name, false);
+    if (rank == keyCount)
+    {
+        return nullptr;
+    }
+    const Word &record = store->get(sortedIds[rank]);
+    return (record.getWord() == name) ? &record : nullptr;
+}
+
+// =========================================
+// ORDERED ACCESS
+// =========================================
+
+/**
+ * Returns an iterator at the alphabetically first word
+ * @return: Iterator (equal to end() for an empty index)
+ */
+EytzingerIndex::Iterator EytzingerIndex::begin() const
+{
+    return Iterator(this, 0);
+}
+
+/**
+ * Returns the past-the-end iterator
+ * @return: End iterator
+ */
+EytzingerIndex::Iterator EytzingerIndex::end() const
+{
+    return Iterator(this, keyCount);
+}
+
+/**
+ * Returns an iterator at the first word not less than a key
+ * @param key: Key to position at
+ * @return: Iterator, or end() if every word is less than the key
+ */
+EytzingerIndex::Iterator EytzingerIndex::lower_bound(std::string_view key) const
+{
+    return Iterator(this, descend(key, false));
+}
+
+/**
+ * Returns an iterator at the first word greater than a key
+ * @param key: Key to position after
+ * @return: Iterator, or end() if no word is greater than the key
+ */
+EytzingerIndex::Iterator EytzingerIndex::upper_bound(std::string_view key) const
+{
+    return Iterator(this, descend(key, true));
+}
+
+/**
+ * Streams the words in [lo, hi] in alphabetical order
+ * Positions once with lower_bound(), then walks the sorted record IDs
+ * @param lo: Smallest word to include
+ * @param hi: Largest word to include
+ * @param limit: Maximum number of results (negative = unlimited)
+ * @param callback: Called once per word in range
+ * @return: Number of results delivered
+ */
+int EytzingerIndex::range(std::string_view lo, std::string_view hi, int limit,
+                          const std::function<void(const Word &)> &callback) const
+{
+    int delivered = 0;
+    for (Iterator it = lower_bound(lo); it != end() && delivered != limit; ++it)
+    {
+        if (it->getWord().compare(hi) > 0)
+        {
+            break;
+        }
+        callback(*it);
+        delivered++;
+    }
+    return delivered;
+}
+
+// =========================================
+// PERFORMANCE MEASUREMENT
+// =========================================
+
+/**
+ * Searches for a word and measures the time taken
+ * @param name: The word to search for
+ * @param result: Reference parameter to store the search result
+ * @return: Time taken for the search in nanoseconds
+ */
+long long EytzingerIndex::searchWithTiming(const std::string &name, const Word *&result) const
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    result = search(name);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// =========================================
+// MEMORY USAGE CALCULATION
+// =========================================
+
+/**
+ * Calculates the memory used by the index
+ * Includes: the 8-byte prefix and 4-byte rank per slot, and the sorted record IDs
+ * @return: Total memory in bytes
+ */
+long long EytzingerIndex::getMemoryUsage() const
+{
+    return static_cast<long long>(sizeof(EytzingerIndex) + prefixStorage.capacity() * sizeof(uint64_t) +
+                                  rankStorage.capacity() * sizeof(uint32_t) +
+                                  sortedIds.capacity() * sizeof(WordId));
+}
+
+/**
+ * Returns the number of words
+ * @return: Key count
+ */
+int EytzingerIndex::getKeyCount() const
+{
+    return static_cast<int>(keyCount);
+}
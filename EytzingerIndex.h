@@ -0,0 +1,217 @@
+#ifndef EYTZINGERINDEX_H
+#define EYTZINGERINDEX_H
+
+#include "WordStore.h"
+#include "BinaryTree.h"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * EytzingerIndex - Read-only ordered index over a built BinaryTree
+ * The sorted keys are laid out in Eytzinger (breadth-first) order in one array:
+ * the children of slot k are 2k and 2k+1, so the top levels of the implicit tree
+ * share cache lines, and the eight descendants three levels below a slot fill
+ * one cache line that is prefetched while the current level is compared
+ * Each slot holds the first 8 bytes of its word as a big-endian integer, so a
+ * comparison is one integer compare (compiled without a branch); only keys that
+ * share those 8 bytes fall back to comparing the words in the WordStore
+ * Same case-sensitive ordering and the same ordered API (iterator, lower_bound,
+ * upper_bound, range) as BinaryTree; iteration walks a plain sorted array
+ * Time Complexity: O(log n) search with no pointer chasing, O(1) per iteration step
+ */
+class EytzingerIndex
+{
+public:
+    /**
+     * Iterator - Alphabetical iterator over the index's words (a position in sorted order)
+     */
+    class Iterator
+    {
+    private:
+        const EytzingerIndex *index; // Index being walked
+        size_t rank;                 // Position in sorted order (getKeyCount() = end)
+
+        friend class EytzingerIndex;
+
+        /**
+         * Constructor used by begin()/end()/lower_bound()/upper_bound()
+         * @param index: Index being walked
+         * @param rank: Position in sorted order
+         */
+        Iterator(const EytzingerIndex *index, size_t rank);
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Word;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Word *;
+        using reference = const Word &;
+
+        /**
+         * Gets the current word
+         * @return: Reference to the record in the WordStore
+         */
+        const Word &operator*() const;
+
+        /**
+         * Gets the current word
+         * @return: Pointer to the record in the WordStore
+         */
+        const Word *operator->() const;
+
+        /**
+         * Advances to the next word alphabetically
+         * @return: This iterator
+         */
+        Iterator &operator++();
+
+        /**
+         * Compares positions
+         * @param other: Iterator over the same index
+         * @return: True if both are at the same word or both at the end
+         */
+        bool operator==(const Iterator &other) const;
+
+        /**
+         * Compares positions
+         * @param other: Iterator over the same index
+         * @return: True if the positions differ
+         */
+        bool operator!=(const Iterator &other) const;
+    };
+
+private:
+    static const size_t LINE_KEYS = 8; // Key prefixes per 64-byte cache line
+
+    const WordStore *store; // Shared record store that record IDs refer to
+
+    std::vector<uint64_t> prefixStorage; // Owned arrays (prefixes over-allocated for alignment)
+    std::vector<uint32_t> rankStorage;
+    std::vector<WordId> sortedIds;
+
+    const uint64_t *prefixes; // Key prefix per Eytzinger slot (1-based, slot 0 unused), 64-byte aligned
+    const uint32_t *ranks;    // Sorted position of the word in each Eytzinger slot (1-based)
+    size_t keyCount;          // Number of words
+
+    // === PRIVATE HELPER FUNCTIONS ===
+
+    /**
+     * Packs the first 8 bytes of a word into an integer that orders like the word
+     * @param word: Word to pack
+     * @return: Big-endian prefix, zero-padded
+     */
+    static uint64_t prefixOf(std::string_view word);
+
+    /**
+     * Fills the Eytzinger arrays from sortedIds by an in-order walk of the implicit tree
+     */
+    void layOut();
+
+    /**
+     * Descends the implicit tree to the first word not less than (or greater than) a key
+     * @param key: Key to position at
+     * @param strict: True for the first word greater than the key (upper bound)
+     * @return: Sorted position of that word, or getKeyCount() if there is none
+     */
+    size_t descend(std::string_view key, bool strict) const;
+
+public:
+    // === CONSTRUCTORS ===
+
+    /**
+     * Constructor for an empty index
+     * @param store: Record store holding the words (must outlive the index)
+     */
+    EytzingerIndex(const WordStore &store);
+
+    /**
+     * Constructor - Lays out the words of a built BinaryTree
+     * @param store: Record store holding the words (must outlive the index)
+     * @param tree: Tree to copy the ordered keys from (only read)
+     */
+    EytzingerIndex(const WordStore &store, const BinaryTree &tree);
+
+    // Views point into the owned arrays, whose buffers survive a move but not a copy
+    EytzingerIndex(const EytzingerIndex &) = delete;
+    EytzingerIndex &operator=(const EytzingerIndex &) = delete;
+    EytzingerIndex(EytzingerIndex &&) = default;
+    EytzingerIndex &operator=(EytzingerIndex &&) = default;
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Searches for a word (case-sensitive, like BinaryTree::search)
+     * @param name: Word to search for
+     * @return: Pointer to the Word record if found, nullptr otherwise
+     */
+    const Word *search(const std::string &name) const;
+
+    // === ORDERED ACCESS ===
+
+    /**
+     * Gets an iterator at the alphabetically first word
+     * @return: Iterator (equal to end() for an empty index)
+     */
+    Iterator begin() const;
+
+    /**
+     * Gets the past-the-end iterator
+     * @return: End iterator
+     */
+    Iterator end() const;
+
+    /**
+     * Gets an iterator at the first word not less than a key (case-sensitive)
+     * @param key: Key to position at
+     * @return: Iterator, or end() if every word is less than the key
+     */
+    Iterator lower_bound(std::string_view key) const;
+
+    /**
+     * Gets an iterator at the first word greater than a key
+     * @param key: Key to position after
+     * @return: Iterator, or end() if no word is greater than the key
+     */
+    Iterator upper_bound(std::string_view key) const;
+
+    /**
+     * Streams the words in [lo, hi] in alphabetical order
+     * Time Complexity: O(log n + k), k = words delivered
+     * @param lo: Smallest word to include
+     * @param hi: Largest word to include
+     * @param limit: Maximum number of results (negative = unlimited)
+     * @param callback: Called once per word in range
+     * @return: Number of results delivered
+     */
+    int range(std::string_view lo, std::string_view hi, int limit,
+              const std::function<void(const Word &)> &callback) const;
+
+    // === PERFORMANCE METRICS ===
+
+    /**
+     * Searches for a word and measures execution time
+     * @param name: Word to search for
+     * @param result: Reference parameter to store search result
+     * @return: Search time in nanoseconds
+     */
+    long long searchWithTiming(const std::string &name, const Word *&result) const;
+
+    /**
+     * Gets the memory used by the prefix, rank and record ID arrays
+     * @return: Memory used in bytes
+     */
+    long long getMemoryUsage() const;
+
+    /**
+     * Gets the number of words
+     * @return: Key count
+     */
+    int getKeyCount() const;
+};
+
+#endif
@@ -1,5 +1,9 @@
 #include "Functions.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 using namespace std;
 
 // =========================================
@@ -7,51 +11,470 @@ using namespace std;
 // =========================================
 
 /**
- * Loads words from a dictionary file into both data structures
- * Reads pipe-delimited file format: Word|PartOfSpeech|Definition
- * Each successfully parsed line creates a Word object inserted into both BST and Trie
+ * Parses every line of a block of dictionary text into Word views
+ * Format: Word|PartOfSpeech|Definition (the definition may itself contain '|')
+ * Delimiters are located by the SIMD DelimiterScanner, which classifies 64 bytes
+ * per step; per line only the first two '|' matter (later ones belong to the
+ * definition). Lines without both fields or with an empty definition are skipped,
+ * and a trailing '\r' from Windows line endings is ignored
+ * The block must start at a line boundary; a final line without '\n' is included
+ * @param text: Block of dictionary text
+ * @param entries: Parsed entries are appended here in file order
+ */
+void parseDictionaryText(string_view text, vector<Word> &entries)
+{
+    DelimiterScanner scanner(text.data(), text.size());
+
+    size_t lineStart = 0;
+    size_t pipes[2] = {0, 0}; // Positions of the first two '|' in the current line
+    int pipeCount = 0;
+
+    while (lineStart < text.size())
+    {
+        size_t position = scanner.next();
+
+        if (position < text.size() && text[position] == '|')
+        {
+            if (pipeCount < 2)
+            {
+                pipes[pipeCount] = position;
+            }
+            pipeCount++;
+            continue;
+        }
+
+        // End of line (or of the text): [lineStart, lineEnd) is one complete line
+        size_t lineEnd = position;
+        if (lineEnd > lineStart && text[lineEnd - 1] == '\r')
+        {
+            lineEnd--;
+        }
+
+        if (pipeCount >= 2 && pipes[1] + 1 < lineEnd)
+        {
+            entries.emplace_back(text.substr(lineStart, pipes[0] - lineStart),
+                                 text.substr(pipes[0] + 1, pipes[1] - pipes[0] - 1),
+                                 text.substr(pipes[1] + 1, lineEnd - pipes[1] - 1));
+        }
+
+        lineStart = position + 1;
+        pipeCount = 0;
+    }
+}
+
+/**
+ * Resolves a requested thread count
+ * @param threadCount: Requested threads (0 or less = one per hardware thread)
+ * @return: Number of threads to use (at least 1)
+ */
+static int resolveThreadCount(int threadCount)
+{
+    if (threadCount > 0)
+    {
+        return threadCount;
+    }
+    int hardwareThreads = static_cast<int>(thread::hardware_concurrency());
+    return (hardwareThreads > 0) ? hardwareThreads : 1;
+}
+
+/**
+ * Loads a dictionary file into the record store and both indexes without printing
+ * 1. Map the file and split it into newline-aligned chunks, one per thread
+ * 2. Parse the chunks in parallel into per-thread Word lists (views, no copies)
+ * 3. Append the records to the store in file order, so IDs match the serial load
+ * 4. Bulk-build the BST on one thread while the Trie is built in parallel by first character
  * @param filename: Path to the dictionary text file
- * @param tree: BinaryTree reference to insert words into
- * @param trie: Trie reference to insert words into
+ * @param store: WordStore that will own every record
+ * @param tree: BinaryTree reference to index the records in
+ * @param trie: Trie reference to index the records in
+ * @param threadCount: Number of threads (0 = one per hardware thread, 1 = serial)
+ * @param bytesLoaded: Set to the size of the file in bytes
+ * @return: Number of records loaded, or -1 if the file can't be opened
  */
-void loadWords(const string &filename, BinaryTree &tree, Trie &trie)
+int buildDictionary(const string &filename, WordStore &store, BinaryTree &tree, Trie &trie,
+                    int threadCount, size_t &bytesLoaded)
 {
-    // Open the dictionary file
-    ifstream file(filename);
-    if (!file.is_open())
+    threadCount = resolveThreadCount(threadCount);
+
+    // Map the dictionary file (kept alive by the store, which the records point into)
+    string_view text;
+    if (!store.mapFile(filename, text))
+    {
+        return -1;
+    }
+    bytesLoaded = text.size();
+
+    // Split into chunks that each start right after a '\n'
+    vector<size_t> boundaries(threadCount + 1, text.size());
+    boundaries[0] = 0;
+    for (int t = 1; t < threadCount; t++)
+    {
+        size_t split = text.size() / threadCount * t;
+        split = max(split, boundaries[t - 1]);
+        size_t lineEnd = text.find('\n', split);
+        boundaries[t] = (lineEnd == string_view::npos) ? text.size() : lineEnd + 1;
+    }
+
+    // Parse chunks in parallel (the calling thread handles the first chunk)
+    vector<vector<Word>> parts(threadCount);
+    vector<thread> parsers;
+    for (int t = 1; t < threadCount; t++)
+    {
+        parsers.emplace_back([&text, &boundaries, &parts, t]()
+                             { parseDictionaryText(text.substr(boundaries[t], boundaries[t + 1] - boundaries[t]), parts[t]); });
+    }
+    parseDictionaryText(text.substr(0, boundaries[1]), parts[0]);
+    for (thread &parser : parsers)
+    {
+        parser.join();
+    }
+
+    // Store the records once, in file order; both indexes only reference their IDs
+    size_t total = 0;
+    for (const vector<Word> &part : parts)
+    {
+        total += part.size();
+    }
+    store.reserve(store.size() + static_cast<int>(total));
+
+    vector<WordId> ids; // Record IDs, in file order
+    ids.reserve(total);
+    for (const vector<Word> &part : parts)
+    {
+        for (const Word &entry : part)
+        {
+            ids.push_back(store.addMapped(entry));
+        }
+    }
+
+    // Build both indexes at the same time; they only read the (now immutable) store
+    if (threadCount > 1)
+    {
+        thread treeBuilder([&tree, &ids]()
+                           { tree.buildFromSorted(ids); });
+        trie.insertAll(ids, threadCount - 1);
+        treeBuilder.join();
+    }
+    else
+    {
+        trie.insertAll(ids, 1);
+        tree.buildFromSorted(std::move(ids));
+    }
+
+    return static_cast<int>(total);
+}
+
+/**
+ * Loads words from a dictionary file into the record store and both indexes
+ * The file is memory-mapped by the WordStore and every record is a view into the
+ * mapping, so parsing performs no per-entry allocation or copy
+ * Parsing and index construction run on multiple threads (see buildDictionary)
+ * Reports load throughput in MB/s and entries/s
+ * @param filename: Path to the dictionary text file
+ * @param store: WordStore that will own every record
+ * @param tree: BinaryTree reference to index the records in
+ * @param trie: Trie reference to index the records in
+ * @param threadCount: Number of threads (0 = one per hardware thread, 1 = serial)
+ */
+void loadWords(const string &filename, WordStore &store, BinaryTree &tree, Trie &trie, int threadCount)
+{
+    auto start = chrono::high_resolution_clock::now();
+
+    size_t bytesLoaded = 0;
+    int count = buildDictionary(filename, store, tree, trie, threadCount, bytesLoaded);
+    if (count < 0)
     {
         cerr << "Cannot open file: " << filename << endl;
         return;
     }
 
-    string line;
-    int count = 0;
+    auto end = chrono::high_resolution_clock::now();
+    double seconds = chrono::duration<double>(end - start).count();
+    double megabytes = bytesLoaded / (1024.0 * 1024.0);
+
+    // Display success message with count and throughput
+    cout << "Successfully loaded " << count << " words from dictionary!" << endl;
+    cout << "Load time: " << fixed << setprecision(1) << (seconds * 1000) << " ms using "
+         << resolveThreadCount(threadCount) << " thread(s), "
+         << DelimiterScanner::getImplementationName() << " delimiter scan ("
+         << (megabytes / seconds) << " MB/s, "
+         << setprecision(0) << (count / seconds) << " entries/s)" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    cout << "========================================" << endl
+         << endl;
+}
+
+/**
+ * Measures how loading scales with the number of threads
+ * Loads the dictionary into fresh structures with 1, 2, 4, 8, 16 and 32 threads,
+ * checks that every result is identical to the serial (1 thread) load, and prints
+ * time, throughput and speedup for each thread count
+ * @param filename: Path to the dictionary text file
+ */
+void benchmarkLoadScaling(const string &filename)
+{
+    cout << "\n========================================" << endl;
+    cout << "   PARALLEL LOAD SCALING (1-32 threads)" << endl;
+    cout << "========================================" << endl;
+    cout << "Hardware threads: " << thread::hardware_concurrency() << "\n"
+         << endl;
+
+    // Serial reference load used to verify the parallel results
+    WordStore referenceStore;
+    BinaryTree referenceTree(referenceStore, TreeMode::AVL);
+    Trie referenceTrie(referenceStore);
+    size_t bytesLoaded = 0;
+    if (buildDictionary(filename, referenceStore, referenceTree, referenceTrie, 1, bytesLoaded) < 0)
+    {
+        cerr << "Cannot open file: " << filename << endl;
+        return;
+    }
+
+    cout << left << setw(10) << "Threads"
+         << setw(12) << "Time (ms)"
+         << setw(12) << "MB/s"
+         << setw(16) << "Entries/s"
+         << setw(10) << "Speedup"
+         << setw(10) << "Identical" << endl;
+    cout << string(70, '-') << endl;
+
+    double serialSeconds = 0;
+    for (int threads = 1; threads <= 32; threads *= 2)
+    {
+        WordStore store;
+        BinaryTree tree(store, TreeMode::AVL);
+        Trie trie(store);
+
+        auto start = chrono::high_resolution_clock::now();
+        int count = buildDictionary(filename, store, tree, trie, threads, bytesLoaded);
+        auto end = chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(end - start).count();
+        if (threads == 1)
+        {
+            serialSeconds = seconds;
+        }
+
+        // Same records in the same order, same shapes, same lookup results
+        bool identical = store.size() == referenceStore.size() &&
+                         tree.getNodeCount() == referenceTree.getNodeCount() &&
+                         tree.getHeight() == referenceTree.getHeight() &&
+                         trie.getNodeCount() == referenceTrie.getNodeCount();
+        for (int id = 0; identical && id < store.size(); id++)
+        {
+            const Word &record = store.get(id);
+            const Word &expected = referenceStore.get(id);
+            string name(record.getWord());
+            const Word *trieResult = trie.search(name);
+            const Word *referenceResult = referenceTrie.search(name);
+            identical = record.getWord() == expected.getWord() &&
+                        record.getDefinition() == expected.getDefinition() &&
+                        (trieResult - &store.get(0)) == (referenceResult - &referenceStore.get(0)) &&
+                        (tree.search(name) - &store.get(0)) == (referenceTree.search(name) - &referenceStore.get(0));
+        }
+
+        cout << left << setw(10) << threads
+             << fixed << setprecision(1)
+             << setw(12) << (seconds * 1000)
+             << setw(12) << (bytesLoaded / (1024.0 * 1024.0) / seconds)
+             << setprecision(0)
+             << setw(16) << (count / seconds)
+             << setprecision(2)
+             << setw(10) << (serialSeconds / seconds)
+             << setw(10) << (identical ? "yes" : "NO") << endl;
+    }
+
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+/**
+ * Adds popularity weights from a weights file or query log to the store's records
+ * A line ending in "|<digits>" adds that count to the word before the '|';
+ * any other line is a logged query and adds 1. Counts saturate at UINT32_MAX
+ * Words are matched case-insensitively through the Trie; the subtree maxima
+ * used by top-k search are recomputed once at the end
+ * @param filename: Path to the weights file
+ * @param store: WordStore whose record weights are raised
+ * @param trie: Trie used to find records by word (and kept in sync)
+ * @return: Number of lines applied to a record, or -1 if the file can't be opened
+ */
+int loadWeights(const string &filename, WordStore &store, Trie &trie)
+{
+    ifstream file(filename);
+    if (!file)
+    {
+        return -1;
+    }
 
-    // Read file line by line
+    int applied = 0;
+    string line;
     while (getline(file, line))
     {
-        stringstream ss(line);
-        string word, partOfSpeech, definition;
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        string word = line;
+        uint64_t count = 1;
+        size_t pipe = line.rfind('|');
+        if (pipe != string::npos && pipe + 1 < line.size() &&
+            all_of(line.begin() + pipe + 1, line.end(), [](char c)
+                   { return isdigit(static_cast<unsigned char>(c)) != 0; }))
+        {
+            word = line.substr(0, pipe);
+            count = strtoull(line.c_str() + pipe + 1, nullptr, 10);
+        }
+        if (word.empty())
+        {
+            continue;
+        }
 
-        // Parse pipe-delimited format: Word|PartOfSpeech|Definition
-        if (getline(ss, word, '|') &&
-            getline(ss, partOfSpeech, '|') &&
-            getline(ss, definition))
+        const Word *record = trie.search(word);
+        if (record == nullptr)
         {
-            // Create Word object and insert into both data structures
-            Word med(word, partOfSpeech, definition);
-            tree.insert(med); // Insert into Binary Search Tree
-            trie.insert(med); // Insert into Trie
-            count++;
+            continue;
         }
+        WordId id = store.idOf(*record);
+        uint64_t weight = min<uint64_t>(store.getWeight(id) + count, UINT32_MAX);
+        store.setWeight(id, static_cast<uint32_t>(weight));
+        applied++;
     }
 
-    file.close();
+    trie.updateMaxWeights();
+    return applied;
+}
 
-    // Display success message with count
-    cout << "Successfully loaded " << count << " words from dictionary!" << endl;
+// =========================================
+// SNAPSHOT FUNCTIONS
+// =========================================
+
+/**
+ * Restores every structure from a binary snapshot instead of parsing the text file
+ * Startup cost is one mmap, a checksum pass, and one pass over the record table
+ * to rebuild the Word views; the tree, Trie and frozen Trie arrays are used in place
+ * All checks that can reject the file, down to every stored child index and
+ * record ID, run before any structure is touched; a rejected snapshot leaves the
+ * structures empty, so the caller can fall back to the text file
+ * @param snapshotFile: Path to the snapshot
+ * @param textFile: Path to the dictionary text file it was built from
+ * @param store: Empty WordStore to restore
+ * @param tree: Empty BinaryTree to restore
+ * @param trie: Empty Trie to restore
+ * @param frozenTrie: Empty DoubleArrayTrie to restore
+ * @return: True if the structures were restored
+ */
+bool loadSnapshot(const string &snapshotFile, const string &textFile, WordStore &store,
+                  BinaryTree &tree, Trie &trie, DoubleArrayTrie &frozenTrie)
+{
+    auto start = chrono::high_resolution_clock::now();
+
+    // A snapshot older than the text it was built from is stale
+    error_code error;
+    auto snapshotTime = filesystem::last_write_time(snapshotFile, error);
+    if (error)
+    {
+        return false;
+    }
+    auto textTime = filesystem::last_write_time(textFile, error);
+    bool haveText = !error;
+    if (haveText && textTime > snapshotTime)
+    {
+        cout << "Snapshot is older than " << textFile << "; rebuilding" << endl;
+        return false;
+    }
+
+    SnapshotReader reader;
+    if (!reader.open(snapshotFile))
+    {
+        cout << "Snapshot " << snapshotFile << " is invalid or from another version; rebuilding" << endl;
+        return false;
+    }
+    if (haveText && reader.getSourceSize() != filesystem::file_size(textFile, error))
+    {
+        cout << "Snapshot does not match " << textFile << "; rebuilding" << endl;
+        return false;
+    }
+
+    const SnapshotSection required[] = {
+        SnapshotSection::STORE_TEXT, SnapshotSection::STORE_RECORDS, SnapshotSection::TREE_NODES,
+        SnapshotSection::TRIE_NODES, SnapshotSection::TRIE_SLOTS, SnapshotSection::FROZEN_UNITS,
+        SnapshotSection::FROZEN_VALUES, SnapshotSection::FROZEN_FIRST_CHILD, SnapshotSection::FROZEN_NEXT_SIBLING};
+    for (SnapshotSection id : required)
+    {
+        if (reader.find(id) == nullptr)
+        {
+            return false;
+        }
+    }
+    if (reader.find(SnapshotSection::TREE_NODES)->param1 != static_cast<uint64_t>(tree.getMode()))
+    {
+        cout << "Snapshot was built for another tree mode; rebuilding" << endl;
+        return false;
+    }
+
+    // Check every index and record ID before any structure adopts the mapping, so
+    // a bad snapshot leaves everything empty for the text load
+    uint32_t recordCount = reader.find(SnapshotSection::STORE_RECORDS)->count;
+    if (store.size() != 0 || tree.getNodeCount() != 0 || trie.getNodeCount() != 0 ||
+        !WordStore::checkSnapshot(reader) || !tree.checkSnapshot(reader, recordCount) ||
+        !Trie::checkSnapshot(reader, recordCount) || !DoubleArrayTrie::checkSnapshot(reader, recordCount))
+    {
+        cout << "Snapshot " << snapshotFile << " is inconsistent; rebuilding" << endl;
+        return false;
+    }
+
+    // Empty structures and consistent sections: none of these can fail now
+    reader.attachTo(store);
+    store.readSnapshot(reader);
+    tree.readSnapshot(reader);
+    trie.readSnapshot(reader);
+    frozenTrie.readSnapshot(reader);
+
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Successfully loaded " << store.size() << " words from snapshot " << snapshotFile << "!" << endl;
+    cout << "Load time: " << fixed << setprecision(1)
+         << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
     cout << "========================================" << endl
          << endl;
+    return true;
+}
+
+/**
+ * Writes every structure to a binary snapshot for the next start
+ * @param snapshotFile: Destination path (replaced atomically)
+ * @param textFile: Path to the dictionary text file the structures were built from
+ * @param store: Loaded WordStore
+ * @param tree: Built BinaryTree
+ * @param trie: Built Trie
+ * @param frozenTrie: Frozen copy of the Trie
+ * @return: True on success
+ */
+bool saveSnapshot(const string &snapshotFile, const string &textFile, const WordStore &store,
+                  const BinaryTree &tree, const Trie &trie, const DoubleArrayTrie &frozenTrie)
+{
+    error_code error;
+    uint64_t sourceSize = filesystem::file_size(textFile, error);
+    if (error)
+    {
+        return false;
+    }
+
+    SnapshotWriter writer;
+    store.writeSnapshot(writer);
+    tree.writeSnapshot(writer);
+    trie.writeSnapshot(writer);
+    frozenTrie.writeSnapshot(writer);
+
+    if (!writer.writeFile(snapshotFile, sourceSize))
+    {
+        cerr << "Cannot write snapshot: " << snapshotFile << endl;
+        return false;
+    }
+    return true;
 }
 
 // =========================================
@@ -70,8 +493,19 @@ void displayMenu()
     cout << "1. Search for a word" << endl;
     cout << "2. Display Binary Tree structure" << endl;
     cout << "3. Display Trie structure" << endl;
-    cout << "4. Compare performance: Binary Tree vs Trie" << endl;
+    cout << "4. Compare performance: Binary Tree vs Tries vs Hash" << endl;
     cout << "5. Display memory usage" << endl;
+    cout << "6. Benchmark parallel loading (1-32 threads)" << endl;
+    cout << "7. Prefix search (alphabetical)" << endl;
+    cout << "8. Top-k autocomplete (by weight)" << endl;
+    cout << "9. Browse words alphabetically" << endl;
+    cout << "10. Pattern search (? and * wildcards)" << endl;
+    cout << "11. Benchmark batched lookups" << endl;
+    cout << "12. Benchmark multi-threaded query throughput" << endl;
+    cout << "13. Stress-test concurrent reads during updates" << endl;
+    cout << "14. Benchmark static ordered index vs BST" << endl;
+    cout << "15. Stress-test deep trees on a 256 KB stack" << endl;
+    cout << "16. Count heap allocations per lookup" << endl;
     cout << "0. Exit" << endl;
     cout << "========================================" << endl;
     cout << "Enter your choice: ";
@@ -82,13 +516,16 @@ void displayMenu()
 // =========================================
 
 /**
- * Searches for a user-specified word in both data structures
- * Displays results and timing comparison between BST and Trie
- * Shows which structure performed faster for this particular search
+ * Searches for a user-specified word in the exact-lookup structures
+ * Displays results and timing comparison between the BST, Trie and hash index
+ * Shows which structure performed fastest for this particular search
+ * If none finds the word, lists up to 5 words within 2 edits
  * @param tree: BinaryTree to search in
- * @param trie: Trie to search in
+ * @param trie: Frozen (double-array) Trie to search in
+ * @param hashIndex: HashIndex to search in
+ * @param suggestions: Trie used for fuzzy suggestions
  */
-void searchWord(BinaryTree &tree, Trie &trie)
+void searchWord(BinaryTree &tree, const DoubleArrayTrie &trie, const HashIndex &hashIndex, const Trie &suggestions)
 {
     string name;
     cout << "\nEnter word to search: ";
@@ -96,7 +533,7 @@ void searchWord(BinaryTree &tree, Trie &trie)
     getline(cin, name);
 
     cout << "\n--- BINARY TREE SEARCH RESULT ---" << endl;
-    Word *resultTree = nullptr;
+    const Word *resultTree = nullptr;
     long long timeTree = tree.searchWithTiming(name, resultTree);
 
     if (resultTree != nullptr)
@@ -110,7 +547,7 @@ void searchWord(BinaryTree &tree, Trie &trie)
     }
 
     cout << "\n--- TRIE SEARCH RESULT ---" << endl;
-    Word *resultTrie = nullptr;
+    const Word *resultTrie = nullptr;
     long long timeTrie = trie.searchWithTiming(name, resultTrie);
 
     if (resultTrie != nullptr)
@@ -123,156 +560,1374 @@ void searchWord(BinaryTree &tree, Trie &trie)
         cout << "Word not found in dictionary!" << endl;
     }
 
-    if (resultTree != nullptr || resultTrie != nullptr)
+    cout << "\n--- HASH INDEX SEARCH RESULT ---" << endl;
+    const Word *resultHash = nullptr;
+    long long timeHash = hashIndex.searchWithTiming(name, resultHash);
+
+    if (resultHash != nullptr)
+    {
+        resultHash->display();
+        cout << "Search time: " << timeHash << " nanoseconds" << endl;
+    }
+    else
+    {
+        cout << "Word not found in dictionary!" << endl;
+    }
+
+    if (resultTree == nullptr && resultTrie == nullptr && resultHash == nullptr)
+    {
+        cout << "\n--- DID YOU MEAN ---" << endl;
+        auto start = chrono::high_resolution_clock::now();
+        int count = printFuzzyMatches(suggestions, name, 2, 5);
+        auto end = chrono::high_resolution_clock::now();
+        if (count == 0)
+        {
+            cout << "No words within 2 edits." << endl;
+        }
+        cout << "Fuzzy search time: " << chrono::duration_cast<chrono::microseconds>(end - start).count()
+             << " microseconds" << endl;
+    }
+
+    if (resultTree != nullptr || resultTrie != nullptr || resultHash != nullptr)
     {
         cout << "\n--- COMPARISON ---" << endl;
         cout << "Binary Tree: " << timeTree << " ns" << endl;
         cout << "Trie: " << timeTrie << " ns" << endl;
-        if (timeTree < timeTrie)
-        {
-            cout << "Binary Tree is faster by " << (timeTrie - timeTree) << " ns" << endl;
-        }
-        else
-        {
-            cout << "Trie is faster by " << (timeTree - timeTrie) << " ns" << endl;
-        }
+        cout << "Hash Index: " << timeHash << " ns" << endl;
+
+        // Rank the three timings; report the lead over the runner-up
+        pair<long long, const char *> timings[] = {
+            {timeTree, "Binary Tree"}, {timeTrie, "Trie"}, {timeHash, "Hash Index"}};
+        stable_sort(begin(timings), end(timings), [](const pair<long long, const char *> &a, const pair<long long, const char *> &b)
+                    { return a.first < b.first; });
+        cout << timings[0].second << " is faster by " << (timings[1].first - timings[0].first) << " ns" << endl;
     }
 }
 
-// =========================================
-// PERFORMANCE COMPARISON
-// =========================================
+/**
+ * Prints the words within an edit distance of a query with their distances
+ * @param trie: Trie to search
+ * @param word: Query word (case-insensitive)
+ * @param maxEdits: Maximum Levenshtein distance
+ * @param limit: Maximum number of words to print (negative = unlimited)
+ * @return: Number of words printed
+ */
+int printFuzzyMatches(const Trie &trie, const string &word, int maxEdits, int limit)
+{
+    return trie.fuzzySearch(word, maxEdits, limit, [](const Word &match, int distance)
+                            { cout << match.getWord() << " (" << distance << " edit" << (distance == 1 ? "" : "s")
+                                   << ")" << endl; });
+}
 
 /**
- * Performs batch performance testing on predefined test cases
- * Searches each test word in both structures and compares timing
- * Calculates and displays statistics including averages and winner
- * @param tree: BinaryTree to test
- * @param trie: Trie to test
- * @param testCases: Vector of words to search for
+ * Prints the words starting with a prefix in lexicographic order, one per line
+ * Words are streamed from the Trie straight to the output, nothing is collected
+ * @param trie: Trie to enumerate
+ * @param prefix: Prefix to match (case-insensitive)
+ * @param limit: Maximum number of words to print (negative = unlimited)
+ * @return: Number of words printed
  */
-void comparePerformance(BinaryTree &tree, Trie &trie, const vector<string> &testCases)
+int printPrefixMatches(const Trie &trie, const string &prefix, int limit)
 {
-    cout << "\n========================================" << endl;
-    cout << "  PERFORMANCE COMPARISON: TREE vs TRIE" << endl;
-    cout << "========================================" << endl;
+    return trie.forEachWithPrefix(prefix, limit, [](const Word &word)
+                                  { cout << word.getWord() << endl; });
+}
+
+/**
+ * Prints the k heaviest words starting with a prefix with their weights
+ * @param trie: Trie to search
+ * @param prefix: Prefix to match (case-insensitive)
+ * @param k: Maximum number of words to print (negative = unlimited)
+ * @return: Number of words printed
+ */
+int printTopCompletions(const Trie &trie, const string &prefix, int k)
+{
+    return trie.forEachTopCompletion(prefix, k, [](const Word &word, uint32_t weight)
+                                     { cout << word.getWord() << " (" << weight << ")" << endl; });
+}
 
-    long long totalTimeTree = 0;
-    long long totalTimeTrie = 0;
-    int successTree = 0, successTrie = 0;
+/**
+ * Prompts user for a prefix and k and lists the top-k completions by weight
+ * The search runs once untimed into a buffer, so the reported time excludes printing
+ * @param trie: Trie to search
+ */
+void autocomplete(const Trie &trie)
+{
+    string prefix;
+    int k;
+    cout << "\nEnter prefix: ";
+    cin.ignore();
+    getline(cin, prefix);
+    cout << "Number of completions (k): ";
+    cin >> k;
 
-    cout << "\nPerforming " << testCases.size() << " searches...\n"
-         << endl;
+    vector<pair<const Word *, uint32_t>> results;
+    auto start = chrono::high_resolution_clock::now();
+    trie.forEachTopCompletion(prefix, k, [&results](const Word &word, uint32_t weight)
+                              { results.emplace_back(&word, weight); });
+    auto end = chrono::high_resolution_clock::now();
 
-    // Display table header
-    cout << left << setw(20) << "Word"
-         << setw(15) << "Tree (ns)"
-         << setw(15) << "Trie (ns)"
-         << setw(15) << "Winner" << endl;
-    cout << string(65, '-') << endl;
+    cout << "\n--- TOP " << k << " COMPLETIONS OF \"" << prefix << "\" ---" << endl;
+    if (results.empty())
+    {
+        cout << "No words found with this prefix!" << endl;
+    }
+    for (const auto &result : results)
+    {
+        cout << result.first->getWord() << " (" << result.second << ")" << endl;
+    }
+    cout << "\nSearch time: " << chrono::duration_cast<chrono::nanoseconds>(end - start).count()
+         << " nanoseconds" << endl;
+}
 
-    // Test each word in both structures
-    for (const string &testCase : testCases)
+/**
+ * Prints the words matching a wildcard pattern in alphabetical order
+ * @param trie: Trie to search
+ * @param pattern: Pattern with '?' (any one character) and '*' (any run)
+ * @param limit: Maximum number of words to print (negative = unlimited)
+ * @param nodeBudget: Maximum number of trie nodes to visit (negative = unlimited)
+ * @return: Number of words printed
+ */
+int printPatternMatches(const Trie &trie, const string &pattern, int limit, long long nodeBudget)
+{
+    bool budgetExceeded = false;
+    int count = trie.matchPattern(pattern, limit, nodeBudget, [](const Word &word)
+                                  { cout << word.getWord() << endl; }, &budgetExceeded);
+    if (budgetExceeded)
     {
-        Word *resultTree = nullptr;
-        Word *resultTrie = nullptr;
+        cout << "(search stopped after " << nodeBudget << " nodes; results may be incomplete)" << endl;
+    }
+    return count;
+}
 
-        // Search and time both structures
-        long long timeTree = tree.searchWithTiming(testCase, resultTree);
-        long long timeTrie = trie.searchWithTiming(testCase, resultTrie);
+/**
+ * Prompts user for a wildcard pattern and a result limit and lists the matches
+ * @param trie: Trie to search
+ * @param nodeBudget: Maximum number of trie nodes to visit per query
+ */
+void patternSearch(const Trie &trie, long long nodeBudget)
+{
+    string pattern;
+    int limit;
+    cout << "\nEnter pattern (? = any letter, * = any run): ";
+    cin.ignore();
+    getline(cin, pattern);
+    cout << "Maximum results (negative = all): ";
+    cin >> limit;
 
-        // Accumulate totals
-        totalTimeTree += timeTree;
-        totalTimeTrie += timeTrie;
+    cout << "\n--- WORDS MATCHING \"" << pattern << "\" ---" << endl;
+    auto start = chrono::high_resolution_clock::now();
+    int count = printPatternMatches(trie, pattern, limit, nodeBudget);
+    auto end = chrono::high_resolution_clock::now();
+
+    if (count == 0)
+    {
+        cout << "No words match this pattern!" << endl;
+    }
+    cout << "\n"
+         << count << " word(s) listed in "
+         << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
+}
 
-        // Count successful searches
-        if (resultTree != nullptr)
-            successTree++;
-        if (resultTrie != nullptr)
-            successTrie++;
+/**
+ * Prints the words in [lo, hi] in alphabetical order, one per line
+ * @param index: Static ordered index to walk
+ * @param lo: Smallest word to include (case-sensitive)
+ * @param hi: Largest word to include (case-sensitive)
+ * @param limit: Maximum number of words to print (negative = unlimited)
+ * @return: Number of words printed
+ */
+int printWordRange(const EytzingerIndex &index, const string &lo, const string &hi, int limit)
+{
+    return index.range(lo, hi, limit, [](const Word &word)
+                      { cout << word.getWord() << endl; });
+}
 
-        // Display individual result
-        cout << left << setw(20) << testCase
-             << setw(15) << timeTree
-             << setw(15) << timeTrie;
+/**
+ * Pages through the dictionary alphabetically
+ * Lists the page starting at the first word not less than the given one, then
+ * offers the next page; each page costs O(log n + page size) (one lower_bound,
+ * then iterator steps), and continuing resumes the same iterator
+ * @param index: Static ordered index to walk
+ */
+void browseWords(const EytzingerIndex &index)
+{
+    string start;
+    int pageSize;
+    cout << "\nStart at word (case-sensitive): ";
+    cin.ignore();
+    getline(cin, start);
+    cout << "Words per page: ";
+    cin >> pageSize;
+    if (pageSize <= 0)
+    {
+        cout << "Page size must be positive!" << endl;
+        return;
+    }
 
-        // Show winner for this search
-        if (timeTree < timeTrie)
+    EytzingerIndex::Iterator it = index.lower_bound(start);
+    char more = 'y';
+    while (more == 'y' || more == 'Y')
+    {
+        cout << "\n--- WORDS FROM \"" << (it != index.end() ? string(it->getWord()) : start) << "\" ---" << endl;
+        int shown = 0;
+        for (; it != index.end() && shown < pageSize; ++it, shown++)
         {
-            cout << "Tree +" << (timeTrie - timeTree) << " ns";
+            cout << it->getWord() << endl;
         }
-        else
+
+        if (it == index.end())
         {
-            cout << "Trie +" << (timeTree - timeTrie) << " ns";
+            cout << "(end of dictionary)" << endl;
+            break;
         }
-        cout << endl;
+        cout << "Next page? (y/n): ";
+        cin >> more;
     }
+}
+
+/**
+ * Prompts user for a prefix and a result limit and lists the matching words
+ * Reports how long the enumeration took
+ * @param trie: Trie to enumerate
+ */
+void prefixSearch(const Trie &trie)
+{
+    string prefix;
+    int limit;
+    cout << "\nEnter prefix: ";
+    cin.ignore();
+    getline(cin, prefix);
+    cout << "Maximum results (negative = all): ";
+    cin >> limit;
 
-    // Display summary statistics
-    cout << string(65, '-') << endl;
-    cout << "\n--- SUMMARY ---" << endl;
-    cout << "Total time (Tree): " << totalTimeTree << " ns" << endl;
-    cout << "Total time (Trie): " << totalTimeTrie << " ns" << endl;
-    cout << "Average (Tree): " << (totalTimeTree / testCases.size()) << " ns" << endl;
-    cout << "Average (Trie): " << (totalTimeTrie / testCases.size()) << " ns" << endl;
-    cout << "Found (Tree): " << successTree << "/" << testCases.size() << endl;
-    cout << "Found (Trie): " << successTrie << "/" << testCases.size() << endl;
+    cout << "\n--- WORDS STARTING WITH \"" << prefix << "\" ---" << endl;
+    auto start = chrono::high_resolution_clock::now();
+    int count = printPrefixMatches(trie, prefix, limit);
+    auto end = chrono::high_resolution_clock::now();
 
-    // Determine overall winner with percentage
-    if (totalTimeTree < totalTimeTrie)
+    if (count == 0)
     {
-        double percent = ((double)(totalTimeTrie - totalTimeTree) / totalTimeTrie) * 100;
-        cout << "\n=> Binary Tree is faster than Trie by " << fixed << setprecision(2)
-             << percent << "%" << endl;
-    }
-    else
-    {
-        double percent = ((double)(totalTimeTree - totalTimeTrie) / totalTimeTree) * 100;
-        cout << "\n=> Trie is faster than Binary Tree by " << fixed << setprecision(2)
-             << percent << "%" << endl;
+        cout << "No words found with this prefix!" << endl;
     }
+    cout << "\n"
+         << count << " word(s) listed in "
+         << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
 }
 
 // =========================================
-// MEMORY USAGE ANALYSIS
+// PERFORMANCE COMPARISON
 // =========================================
 
 /**
- * Displays detailed memory usage information for both data structures
- * Shows node count, total memory in bytes and KB, and percentage comparison
- * @param tree: BinaryTree to analyze
- * @param trie: Trie to analyze
+ * Compares the lookup speed of every structure with the benchmark harness
+ * Four workloads are drawn from the whole dictionary (uniform or Zipfian, hits or
+ * misses); every structure gets the same keys, warmup and number of samples
+ * For each workload, prints per-lookup min/median/p99 with the 95% confidence
+ * interval of the median, and names a winner only when its interval does not
+ * overlap the runner-up's
+ * @param store: WordStore the workloads are drawn from
+ * @param tree: BinaryTree to test
+ * @param trie: Trie to test
+ * @param frozenTrie: Double-array form of the Trie to test
+ * @param radix: RadixTrie (path-compressed Trie) to test
+ * @param dawg: Dawg (minimized automaton) to test
+ * @param hashIndex: HashIndex (exact match only) to test
+ * @param jsonFile: Where to write the results as JSON ("" = don't write)
  */
-void displayMemoryUsage(BinaryTree &tree, Trie &trie)
+void comparePerformance(const WordStore &store, const BinaryTree &tree, const Trie &trie,
+                        const DoubleArrayTrie &frozenTrie, const RadixTrie &radix, const Dawg &dawg,
+                        const HashIndex &hashIndex, const string &jsonFile)
 {
     cout << "\n========================================" << endl;
-    cout << "         MEMORY USAGE" << endl;
+    cout << "  PERFORMANCE COMPARISON: TREE vs TRIES vs HASH" << endl;
     cout << "========================================" << endl;
 
-    int treeMemory = tree.getMemoryUsage();
-    int trieMemory = trie.getMemoryUsage();
-
-    cout << "Binary Tree:" << endl;
-    cout << "  - Number of nodes: " << tree.getNodeCount() << endl;
-    cout << "  - Memory used: " << treeMemory << " bytes (~"
-         << (treeMemory / 1024.0) << " KB)" << endl;
-
-    cout << "\nTrie:" << endl;
-    cout << "  - Number of nodes: " << trie.getNodeCount() << endl;
-    cout << "  - Memory used: " << trieMemory << " bytes (~"
-         << (trieMemory / 1024.0) << " KB)" << endl;
+    BenchmarkHarness harness;
+    const BenchmarkConfig &config = harness.getConfig();
+    cout << fixed << setprecision(1);
+    cout << "Each sample times " << config.keysPerWorkload << " lookups; " << config.samples
+         << " samples per structure and workload after " << config.warmupRounds << " warmup passes" << endl;
+    cout << "Timer overhead: " << harness.getTimerOverhead() << " ns per sample (subtracted)" << endl;
 
-    cout << "\n--- COMPARISON ---" << endl;
-    if (treeMemory < trieMemory)
+    struct Workload
     {
-        double percent = ((double)(trieMemory - treeMemory) / trieMemory) * 100;
-        cout << "Binary Tree uses less memory by " << (trieMemory - treeMemory)
-             << " bytes (" << fixed << setprecision(2) << percent << "% )" << endl;
-    }
-    else
+        const char *name;
+        KeyDistribution distribution;
+        bool hits;
+    };
+    const Workload workloads[] = {
+        {"uniform-hit", KeyDistribution::UNIFORM, true},
+        {"uniform-miss", KeyDistribution::UNIFORM, false},
+        {"zipf-hit", KeyDistribution::ZIPFIAN, true},
+        {"zipf-miss", KeyDistribution::ZIPFIAN, false},
+    };
+
+    for (const Workload &workload : workloads)
     {
-        double percent = ((double)(treeMemory - trieMemory) / treeMemory) * 100;
+        vector<string> keys = harness.makeWorkload(store, trie, workload.distribution, workload.hits);
+
+        vector<BenchmarkResult> rows;
+        rows.push_back(harness.measure("Tree", workload.name, keys, [&tree](const string &key)
+                                       { return tree.search(key); }));
+        rows.push_back(harness.measure("Trie", workload.name, keys, [&trie](const string &key)
+                                       { return trie.search(key); }));
+        rows.push_back(harness.measure("Frozen Trie", workload.name, keys, [&frozenTrie](const string &key)
+                                       { return frozenTrie.search(key); }));
+        rows.push_back(harness.measure("Radix", workload.name, keys, [&radix](const string &key)
+                                       { return radix.search(key); }));
+        rows.push_back(harness.measure("DAWG", workload.name, keys, [&dawg](const string &key)
+                                       { return dawg.search(key); }));
+        rows.push_back(harness.measure("Hash", workload.name, keys, [&hashIndex](const string &key)
+                                       { return hashIndex.search(key); }));
+
+        cout << "\n--- " << workload.name << " (ns per lookup) ---" << endl;
+        cout << left << setw(14) << "Structure"
+             << setw(10) << "Median"
+             << setw(20) << "95% CI (median)"
+             << setw(10) << "Min"
+             << setw(10) << "p99"
+             << setw(10) << "Hit rate" << endl;
+        cout << string(74, '-') << endl;
+        for (const BenchmarkResult &row : rows)
+        {
+            ostringstream interval;
+            interval << fixed << setprecision(1) << "[" << row.stats.medianLow << ", " << row.stats.medianHigh << "]";
+            cout << left << setw(14) << row.structure
+                 << setw(10) << row.stats.median
+                 << setw(20) << interval.str()
+                 << setw(10) << row.stats.min
+                 << setw(10) << row.stats.p99
+                 << setw(10) << row.hitRate << endl;
+        }
+
+        // Winner only if its median is clearly below the runner-up's
+        vector<size_t> order(rows.size());
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            order[i] = i;
+        }
+        sort(order.begin(), order.end(), [&rows](size_t a, size_t b)
+             { return rows[a].stats.median < rows[b].stats.median; });
+        const BenchmarkResult &fastest = rows[order[0]];
+        const BenchmarkResult &runnerUp = rows[order[1]];
+        if (fastest.stats.medianHigh < runnerUp.stats.medianLow)
+        {
+            cout << "=> " << fastest.structure << " is fastest, "
+                 << (100.0 * (runnerUp.stats.median - fastest.stats.median) / runnerUp.stats.median)
+                 << "% below " << runnerUp.structure << endl;
+        }
+        else
+        {
+            cout << "=> " << fastest.structure << " and " << runnerUp.structure
+                 << " are within noise (95% intervals overlap)" << endl;
+        }
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+
+    if (!jsonFile.empty())
+    {
+        if (harness.writeJson(jsonFile))
+        {
+            cout << "\nResults written to " << jsonFile << endl;
+        }
+        else
+        {
+            cerr << "Cannot write " << jsonFile << endl;
+        }
+    }
+}
+
+/**
+ * Builds the key set of the lookup benchmarks: every word in the store plus
+ * one miss per eight words, shuffled with a fixed seed so runs are comparable
+ * @param store: WordStore whose words are used as keys
+ * @return: Shuffled keys
+ */
+static vector<string> makeLookupKeys(const WordStore &store)
+{
+    vector<string> keys;
+    for (int id = 0; id < store.size(); id++)
+    {
+        keys.emplace_back(store.get(id).getWord());
+        if (id % 8 == 0)
+        {
+            keys.push_back(keys.back() + "#");
+        }
+    }
+    shuffle(keys.begin(), keys.end(), mt19937(12345));
+    return keys;
+}
+
+/**
+ * Compares one-at-a-time lookups with batched (interleaved) lookups
+ * Every word in the store is looked up in shuffled order, so nearly every
+ * lookup misses the cache; batching overlaps those misses across keys.
+ * The batched results are checked against the serial ones
+ * @param tree: BinaryTree to test
+ * @param trie: Trie to test
+ * @param store: WordStore whose words are used as keys
+ */
+void benchmarkBatchLookup(const BinaryTree &tree, const Trie &trie, const WordStore &store)
+{
+    cout << "\n========================================" << endl;
+    cout << "   BATCHED LOOKUP (memory-level parallelism)" << endl;
+    cout << "========================================" << endl;
+
+    vector<string> keys = makeLookupKeys(store);
+    vector<string_view> views(keys.begin(), keys.end());
+    size_t count = keys.size();
+
+    cout << "Keys: " << count << "\n"
+         << endl;
+    cout << left << setw(10) << "Index"
+         << setw(10) << "Batch"
+         << setw(12) << "Time (ms)"
+         << setw(16) << "Lookups/s"
+         << setw(10) << "Speedup"
+         << setw(10) << "Identical" << endl;
+    cout << string(68, '-') << endl;
+
+    struct BatchContender
+    {
+        string name;
+        function<const Word *(const string &)> search;
+        function<void(const string_view *, size_t, const Word **)> searchBatch;
+    };
+    vector<BatchContender> contenders = {
+        {"Tree", [&tree](const string &name)
+         { return tree.search(name); },
+         [&tree](const string_view *names, size_t n, const Word **results)
+         { tree.searchBatch(names, n, results); }},
+        {"Trie", [&trie](const string &name)
+         { return trie.search(name); },
+         [&trie](const string_view *names, size_t n, const Word **results)
+         { trie.searchBatch(names, n, results); }},
+    };
+
+    const size_t batchSizes[] = {1, 8, 32, 128};
+    for (const BatchContender &contender : contenders)
+    {
+        // Serial baseline, which also provides the expected results
+        vector<const Word *> expected(count);
+        auto start = chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < count; i++)
+        {
+            expected[i] = contender.search(keys[i]);
+        }
+        auto end = chrono::high_resolution_clock::now();
+        double serialSeconds = chrono::duration<double>(end - start).count();
+
+        cout << left << setw(10) << contender.name
+             << setw(10) << "serial"
+             << fixed << setprecision(1)
+             << setw(12) << (serialSeconds * 1000)
+             << setprecision(0)
+             << setw(16) << (count / serialSeconds)
+             << setprecision(2)
+             << setw(10) << 1.0
+             << setw(10) << "-" << endl;
+
+        for (size_t batch : batchSizes)
+        {
+            vector<const Word *> results(count);
+            start = chrono::high_resolution_clock::now();
+            for (size_t first = 0; first < count; first += batch)
+            {
+                contender.searchBatch(&views[first], min(batch, count - first), &results[first]);
+            }
+            end = chrono::high_resolution_clock::now();
+            double seconds = chrono::duration<double>(end - start).count();
+
+            cout << left << setw(10) << contender.name
+                 << setw(10) << batch
+                 << fixed << setprecision(1)
+                 << setw(12) << (seconds * 1000)
+                 << setprecision(0)
+                 << setw(16) << (count / seconds)
+                 << setprecision(2)
+                 << setw(10) << (serialSeconds / seconds)
+                 << setw(10) << (results == expected ? "yes" : "NO") << endl;
+        }
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+/**
+ * Measures multi-threaded query throughput with a QueryEngine
+ * For each index, answers the shuffled key set with 1, 2, 4, ... worker threads
+ * up to the hardware thread count and reports aggregate QPS, per-query
+ * p50/p99 latency and speedup; results are checked against a serial run
+ * Each pool first answers one warmup batch (thread start-up, cold caches and
+ * page faults), then QPS is the median of several untimed batches, in which
+ * workers read no clocks; the latencies come from one extra, sampled batch
+ * @param tree: BinaryTree to serve
+ * @param trie: Trie to serve
+ * @param frozenTrie: Frozen (double-array) Trie to serve
+ * @param store: WordStore whose words are used as keys
+ */
+void benchmarkQueryThroughput(const BinaryTree &tree, const Trie &trie, const DoubleArrayTrie &frozenTrie,
+                              const WordStore &store)
+{
+    cout << "\n========================================" << endl;
+    cout << "   QUERY THROUGHPUT (1-N threads)" << endl;
+    cout << "========================================" << endl;
+
+    int hardwareThreads = resolveThreadCount(0);
+    vector<int> threadCounts;
+    for (int threads = 1; threads < hardwareThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    const int QPS_RUNS = 5; // Untimed batches per configuration; the median is reported
+
+    vector<string> keys = makeLookupKeys(store);
+    size_t count = keys.size();
+    cout << "Hardware threads: " << hardwareThreads << ", queries per run: " << count
+         << ", runs: 1 warmup + " << QPS_RUNS << " (median QPS) + 1 latency-sampled\n"
+         << endl;
+
+    cout << left << setw(14) << "Index"
+         << setw(10) << "Threads"
+         << setw(14) << "QPS"
+         << setw(12) << "p50 (ns)"
+         << setw(12) << "p99 (ns)"
+         << setw(10) << "Speedup"
+         << setw(10) << "Identical" << endl;
+    cout << string(82, '-') << endl;
+
+    const pair<const char *, QueryIndex> indexes[] = {
+        {"Tree", QueryIndex::TREE},
+        {"Trie", QueryIndex::TRIE},
+        {"Frozen Trie", QueryIndex::FROZEN_TRIE},
+    };
+    for (const auto &index : indexes)
+    {
+        // Serial answers to check every run against
+        vector<const Word *> expected(count);
+        {
+            QueryEngine engine(tree, trie, frozenTrie, 1);
+            engine.run(keys.data(), count, index.second, expected.data(), false);
+        }
+
+        double baseQps = 0;
+        for (int threads : threadCounts)
+        {
+            QueryEngine engine(tree, trie, frozenTrie, threads);
+            vector<const Word *> results(count);
+            engine.run(keys.data(), count, index.second, results.data(), false);
+
+            vector<double> runQps;
+            bool identical = true;
+            for (int run = 0; run < QPS_RUNS; run++)
+            {
+                fill(results.begin(), results.end(), nullptr);
+                QueryStats stats = engine.run(keys.data(), count, index.second, results.data(), false);
+                runQps.push_back(stats.queries / stats.seconds);
+                identical = identical && results == expected;
+            }
+            nth_element(runQps.begin(), runQps.begin() + QPS_RUNS / 2, runQps.end());
+            double qps = runQps[QPS_RUNS / 2];
+            QueryStats stats = engine.run(keys.data(), count, index.second, results.data());
+
+            if (threads == 1)
+            {
+                baseQps = qps;
+            }
+
+            cout << left << setw(14) << index.first
+                 << setw(10) << threads
+                 << fixed << setprecision(0)
+                 << setw(14) << qps
+                 << setw(12) << stats.p50
+                 << setw(12) << stats.p99
+                 << setprecision(2)
+                 << setw(10) << (qps / baseQps)
+                 << setw(10) << (identical ? "yes" : "NO") << endl;
+        }
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+/**
+ * Compares two words the way Trie::search matches them (ASCII case ignored)
+ * @param a: First word
+ * @param b: Second word
+ * @return: True if they differ only in letter case
+ */
+static bool sameWordIgnoringCase(string_view a, string_view b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Lowercases a word, giving the key under which the Trie stores it
+ * @param word: Word to lowercase
+ * @return: Lowercase copy
+ */
+static string trieKeyOf(string_view word)
+{
+    string key(word);
+    for (char &c : key)
+    {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+    return key;
+}
+
+/**
+ * Stress-tests concurrent mode: reader threads search without locks while one
+ * writer adds new words and corrects existing ones
+ * Readers check that every original word stays findable in both indexes and
+ * that every record they get back matches the word they asked for; afterwards
+ * every update is verified
+ * @param filename: Path to the dictionary file
+ */
+void benchmarkConcurrentUpdates(const string &filename)
+{
+    cout << "\n========================================" << endl;
+    cout << "   CONCURRENT READS DURING UPDATES" << endl;
+    cout << "========================================" << endl;
+
+    WordStore store;
+    BinaryTree tree(store, TreeMode::AVL);
+    Trie trie(store);
+    size_t bytesLoaded = 0;
+    int count = buildDictionary(filename, store, tree, trie, 0, bytesLoaded);
+    if (count <= 0)
+    {
+        cerr << "Cannot open file: " << filename << endl;
+        return;
+    }
+
+    // New words are spread over the whole key space; corrections replace definitions
+    const int NEW_WORDS = 20000;
+    const int CORRECTION_EVERY = 4; // One correction per this many new words
+    vector<string> originals;
+    for (int id = 0; id < count; id++)
+    {
+        originals.emplace_back(store.get(id).getWord());
+    }
+    vector<string> newWords;
+    for (int i = 0; i < NEW_WORDS; i++)
+    {
+        newWords.push_back(originals[(static_cast<size_t>(i) * 7919) % originals.size()] + "-live" + to_string(i));
+    }
+    store.reserve(count + NEW_WORDS + NEW_WORDS / CORRECTION_EVERY); // add() must never move records under readers
+
+    long long treeMemoryBefore = tree.getMemoryUsage();
+    long long trieMemoryBefore = trie.getMemoryUsage();
+
+    EpochManager epochs;
+    tree.enableConcurrentUpdates(epochs);
+    trie.enableConcurrentUpdates(epochs);
+
+    int readerCount = max(2, resolveThreadCount(0) - 1);
+    atomic<bool> stop(false);
+    vector<long long> reads(readerCount, 0);
+    vector<long long> errors(readerCount, 0);
+    vector<thread> readers;
+    for (int r = 0; r < readerCount; r++)
+    {
+        readers.emplace_back([&, r]()
+                             {
+            int reader = epochs.registerReader();
+            mt19937 random(1000 + r);
+            long long done = 0;
+            long long failed = 0;
+            while (!stop.load(memory_order_relaxed))
+            {
+                const string &original = originals[random() % originals.size()];
+                const string &added = newWords[random() % newWords.size()];
+
+                EpochGuard guard(epochs, reader);
+                const Word *inTree = tree.search(original);
+                const Word *inTrie = trie.search(original);
+                const Word *addedInTrie = trie.search(added); // Present or not yet, never wrong
+                // The BST is case-sensitive; the Trie may answer with a case variant of
+                // the word (a dictionary entry or a correction), which is still correct
+                failed += (inTree == nullptr || inTree->getWord() != original) ? 1 : 0;
+                failed += (inTrie == nullptr || !sameWordIgnoringCase(inTrie->getWord(), original)) ? 1 : 0;
+                failed += (addedInTrie != nullptr && !sameWordIgnoringCase(addedInTrie->getWord(), added)) ? 1 : 0;
+                done += 3;
+            }
+            reads[r] = done;
+            errors[r] = failed;
+            epochs.unregisterReader(reader); });
+    }
+
+    // Single writer: add every new word to both indexes, correcting an existing word now and then
+    vector<pair<string, WordId>> corrections;
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < NEW_WORDS; i++)
+    {
+        WordId id = store.add(Word(newWords[i], "n.", "Added while serving"));
+        tree.insert(id);
+        trie.insert(id);
+
+        if (i % CORRECTION_EVERY == 0)
+        {
+            const string &word = originals[(static_cast<size_t>(i) * 104729) % originals.size()];
+            string definition = "[corrected] " + string(trie.search(word)->getDefinition());
+            WordId corrected = store.add(Word(word, "n.", definition));
+            trie.insert(corrected); // The Trie points the word at the new record
+            corrections.emplace_back(word, corrected);
+        }
+    }
+    auto end = chrono::high_resolution_clock::now();
+    stop.store(true);
+    for (thread &reader : readers)
+    {
+        reader.join();
+    }
+    double seconds = chrono::duration<double>(end - start).count();
+
+    long long totalReads = 0;
+    long long totalErrors = 0;
+    for (int r = 0; r < readerCount; r++)
+    {
+        totalReads += reads[r];
+        totalErrors += errors[r];
+    }
+
+    // Every update must be visible once the writer is done (later corrections win)
+    bool updatesVisible = true;
+    for (const string &word : newWords)
+    {
+        const Word *inTree = tree.search(word);
+        const Word *inTrie = trie.search(word);
+        updatesVisible = updatesVisible && inTree != nullptr && inTrie == inTree;
+    }
+    map<string, WordId> latestCorrection; // Keyed like the Trie, so case variants share an entry
+    for (const auto &correction : corrections)
+    {
+        latestCorrection[trieKeyOf(correction.first)] = correction.second;
+    }
+    for (const auto &correction : latestCorrection)
+    {
+        updatesVisible = updatesVisible && trie.search(correction.first) == &store.get(correction.second);
+    }
+
+    int writes = NEW_WORDS * 2 + static_cast<int>(corrections.size());
+    cout << "Reader threads: " << readerCount << ", writer threads: 1" << endl;
+    cout << fixed << setprecision(0);
+    cout << "Writes: " << writes << " in " << setprecision(1) << (seconds * 1000) << " ms ("
+         << setprecision(0) << (writes / seconds) << " writes/s)" << endl;
+    cout << "Reads:  " << totalReads << " (" << (totalReads / seconds) << " reads/s)" << endl;
+    cout << "Wrong or missing read results: " << totalErrors << endl;
+    cout << "All updates visible afterwards: " << (updatesVisible ? "yes" : "NO") << endl;
+    cout << setprecision(2)
+         << "Tree arena: " << (treeMemoryBefore / (1024.0 * 1024.0)) << " MB -> "
+         << (tree.getMemoryUsage() / (1024.0 * 1024.0)) << " MB" << endl;
+    cout << "Trie arenas: " << (trieMemoryBefore / (1024.0 * 1024.0)) << " MB -> "
+         << (trie.getMemoryUsage() / (1024.0 * 1024.0)) << " MB" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+/**
+ * Draws lookup keys for the ordered index benchmark: random words of the store,
+ * with one in four turned into a miss (a '#' appended, which sorts between the
+ * word and its extensions, so the descent still goes all the way down)
+ * @param store: WordStore whose words are used as keys
+ * @param count: Number of keys
+ * @param random: Random generator (seeded by the caller)
+ * @return: Keys
+ */
+static vector<string> makeOrderedQueries(const WordStore &store, size_t count, mt19937 &random)
+{
+    vector<string> keys;
+    keys.reserve(count);
+    uniform_int_distribution<int> record(0, store.size() - 1);
+    for (size_t i = 0; i < count; i++)
+    {
+        keys.emplace_back(store.get(record(random)).getWord());
+        if (i % 4 == 3)
+        {
+            keys.back() += '#';
+        }
+    }
+    return keys;
+}
+
+/**
+ * Measures the tree and the Eytzinger index on the same keys and prints one row
+ * Also checks that search, lower_bound and upper_bound agree on every key and
+ * that both iterate the same words in the same order
+ * @param label: Row label
+ * @param tree: BinaryTree to test
+ * @param index: EytzingerIndex built from the tree
+ * @param keys: Lookup keys
+ * @param harness: Harness that times the lookups
+ */
+static void compareOrderedIndexes(const string &label, const BinaryTree &tree, const EytzingerIndex &index,
+                                  const vector<string> &keys, BenchmarkHarness &harness)
+{
+    // measure() returns a reference into the harness's results, so keep copies
+    BenchmarkStats treeStats = harness.measure("Tree", label, keys, [&tree](const string &key)
+                                               { return tree.search(key); })
+                                   .stats;
+    BenchmarkStats indexStats = harness.measure("Eytzinger", label, keys, [&index](const string &key)
+                                                { return index.search(key); })
+                                    .stats;
+
+    auto samePosition = [&tree, &index](const BinaryTree::Iterator &a, const EytzingerIndex::Iterator &b)
+    {
+        return (a == tree.end()) ? (b == index.end()) : (b != index.end() && &*a == &*b);
+    };
+    bool identical = index.getKeyCount() == tree.getNodeCount();
+    for (const string &key : keys)
+    {
+        identical = identical && tree.search(key) == index.search(key) &&
+                    samePosition(tree.lower_bound(key), index.lower_bound(key)) &&
+                    samePosition(tree.upper_bound(key), index.upper_bound(key));
+    }
+    EytzingerIndex::Iterator walk = index.begin();
+    for (const Word &word : tree)
+    {
+        identical = identical && walk != index.end() && &*walk == &word;
+        ++walk;
+    }
+
+    double keyCount = max(1, tree.getNodeCount());
+    cout << left << setw(22) << label
+         << fixed << setprecision(1)
+         << setw(12) << treeStats.median
+         << setw(16) << indexStats.median
+         << setprecision(2)
+         << setw(10) << (indexStats.median > 0 ? treeStats.median / indexStats.median : 0.0)
+         << setprecision(1)
+         << setw(12) << (tree.getMemoryUsage() / keyCount)
+         << setw(12) << (index.getMemoryUsage() / keyCount)
+         << (identical ? "yes" : "NO") << endl;
+}
+
+/**
+ * Compares BinaryTree::search with the static Eytzinger index built from it
+ * First on the loaded dictionary, then on fresh stores of random lowercase words
+ * (4-12 letters) of 10k to 10M keys, each bulk-loaded into an AVL tree that the
+ * index is built from. Every size gets 200,000 random lookups (1 in 4 a miss),
+ * timed as 5 samples after a warmup pass, so large sizes are measured cold
+ * @param tree: BinaryTree holding the dictionary
+ * @param index: EytzingerIndex built from the tree
+ * @param store: WordStore whose words are used as keys
+ */
+void benchmarkOrderedIndex(const BinaryTree &tree, const EytzingerIndex &index, const WordStore &store)
+{
+    cout << "\n========================================" << endl;
+    cout << "   ORDERED INDEX: BST vs EYTZINGER LAYOUT" << endl;
+    cout << "========================================" << endl;
+
+    const size_t QUERY_COUNT = 200000;
+    const int SIZES[] = {10000, 100000, 1000000, 10000000};
+
+    BenchmarkConfig config;
+    config.samples = 5;
+    config.warmupRounds = 1;
+    BenchmarkHarness harness(config);
+    mt19937 random(20251);
+
+    cout << QUERY_COUNT << " lookups per size (1 in 4 a miss), median of " << config.samples << " samples\n"
+         << endl;
+    cout << left << setw(22) << "Keys"
+         << setw(12) << "Tree (ns)"
+         << setw(16) << "Eytzinger (ns)"
+         << setw(10) << "Speedup"
+         << setw(12) << "Tree B/key"
+         << setw(12) << "Eytz B/key"
+         << "Identical" << endl;
+    cout << string(94, '-') << endl;
+
+    if (store.size() > 0)
+    {
+        compareOrderedIndexes("dictionary (" + to_string(index.getKeyCount()) + ")", tree, index,
+                              makeOrderedQueries(store, QUERY_COUNT, random), harness);
+    }
+
+    for (int size : SIZES)
+    {
+        WordStore synthetic;
+        synthetic.reserve(size);
+        uniform_int_distribution<int> length(4, 12);
+        uniform_int_distribution<int> letter('a', 'z');
+        string text;
+        for (int i = 0; i < size; i++)
+        {
+            text.assign(length(random), ' ');
+            for (char &c : text)
+            {
+                c = static_cast<char>(letter(random));
+            }
+            synthetic.add(Word(text, "n.", ""));
+        }
+
+        vector<WordId> ids(size);
+        iota(ids.begin(), ids.end(), 0);
+        BinaryTree syntheticTree(synthetic, TreeMode::AVL);
+        syntheticTree.buildFromSorted(move(ids));
+        EytzingerIndex syntheticIndex(synthetic, syntheticTree);
+
+        compareOrderedIndexes("random (" + to_string(size) + ")", syntheticTree, syntheticIndex,
+                              makeOrderedQueries(synthetic, QUERY_COUNT, random), harness);
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// =========================================
+// ALLOCATION COUNTING
+// =========================================
+
+/**
+ * Counts the heap allocations made by each exact-lookup structure per lookup
+ * Every key is looked up once to warm up, then once more between two reads of
+ * the operator new counter; nothing else runs meanwhile, so the difference is
+ * what the lookups allocated. A control row copies every found definition into
+ * a std::string, which is what returning the fields by value used to cost
+ * Needs a build with COUNT_ALLOCATIONS; otherwise it only says so
+ * @param tree: BinaryTree to test
+ * @param trie: Trie to test
+ * @param frozenTrie: Frozen (double-array) Trie to test
+ * @param hashIndex: HashIndex to test
+ * @param store: WordStore whose words are used as keys
+ */
+void benchmarkLookupAllocations(const BinaryTree &tree, const Trie &trie, const DoubleArrayTrie &frozenTrie,
+                                const HashIndex &hashIndex, const WordStore &store)
+{
+    cout << "\n========================================" << endl;
+    cout << "   HEAP ALLOCATIONS PER LOOKUP" << endl;
+    cout << "========================================" << endl;
+
+    if (!isHeapAllocationCountAvailable())
+    {
+        cout << "Allocation counting is not available in this build." << endl;
+        cout << "Rebuild with -DCOUNT_ALLOCATIONS (see README) to replace operator new with a counting one." << endl;
+        return;
+    }
+
+    vector<string> keys = makeLookupKeys(store);
+    cout << "Keys: " << keys.size() << " (every word plus misses), counted with a replaced operator new\n"
+         << endl;
+    cout << left << setw(26) << "Lookup"
+         << setw(12) << "Found"
+         << setw(14) << "Allocations"
+         << "Per lookup" << endl;
+    cout << string(62, '-') << endl;
+
+    struct AllocationContender
+    {
+        string name;
+        function<const Word *(const string &)> search;
+    };
+    vector<AllocationContender> contenders = {
+        {"BinaryTree::search", [&tree](const string &name)
+         { return tree.search(name); }},
+        {"Trie::search", [&trie](const string &name)
+         { return trie.search(name); }},
+        {"DoubleArrayTrie::search", [&frozenTrie](const string &name)
+         { return frozenTrie.search(name); }},
+        {"HashIndex::search", [&hashIndex](const string &name)
+         { return hashIndex.search(name); }},
+        {"control: copy definition", [&tree](const string &name)
+         {
+             const Word *result = tree.search(name);
+             if (result != nullptr)
+             {
+                 string copy(result->getDefinition());
+                 return copy.empty() ? nullptr : result;
+             }
+             return result;
+         }},
+    };
+
+    for (const AllocationContender &contender : contenders)
+    {
+        for (const string &key : keys)
+        {
+            contender.search(key);
+        }
+
+        size_t found = 0;
+        unsigned long long before = getHeapAllocationCount();
+        for (const string &key : keys)
+        {
+            found += (contender.search(key) != nullptr) ? 1 : 0;
+        }
+        unsigned long long allocations = getHeapAllocationCount() - before;
+
+        cout << left << setw(26) << contender.name
+             << setw(12) << found
+             << setw(14) << allocations
+             << fixed << setprecision(3) << (static_cast<double>(allocations) / keys.size()) << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// =========================================
+// STACK-SAFETY STRESS TEST
+// =========================================
+
+/**
+ * Runs a task on a new thread with a given stack size and waits for it
+ * Uses pthreads where available; elsewhere (or if the size is refused) the task
+ * runs on a std::thread with the platform's default stack
+ * @param stackBytes: Stack size of the thread
+ * @param task: Work to run
+ * @return: True if the task ran with the requested stack size
+ */
+static bool runWithStackSize(size_t stackBytes, const function<void()> &task)
+{
+#ifndef _WIN32
+    pthread_attr_t attributes;
+    if (pthread_attr_init(&attributes) == 0)
+    {
+        pthread_t worker;
+        bool started = pthread_attr_setstacksize(&attributes, stackBytes) == 0 &&
+                       pthread_create(&worker, &attributes, [](void *argument) -> void *
+                                      {
+                                          (*static_cast<const function<void()> *>(argument))();
+                                          return nullptr; },
+                                      const_cast<function<void()> *>(&task)) == 0;
+        pthread_attr_destroy(&attributes);
+        if (started)
+        {
+            pthread_join(worker, nullptr);
+            return true;
+        }
+    }
+#endif
+    thread(task).join();
+    return false;
+}
+
+/**
+ * Prints one step of the stress test with the time it took
+ * @param step: Step name
+ * @param start: When the step started
+ * @param detail: Result of the step
+ */
+static void printStressStep(const string &step, chrono::steady_clock::time_point start, const string &detail)
+{
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "  " << left << setw(30) << step << right << fixed << setprecision(1) << setw(10) << ms << " ms   "
+         << detail << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+/**
+ * Builds, searches, walks, measures and destroys a degenerate BinaryTree (one
+ * right-leaning chain, height = node count)
+ * Inserting sorted keys one at a time would take O(n^2) comparisons, so the
+ * chain is written as a snapshot and adopted through the normal snapshot load
+ * (which checks every child index) - the tree is the same as if it had been inserted
+ * @param nodeCount: Number of nodes (and tree height)
+ * @param snapshotFile: Scratch file for the chain (removed again)
+ */
+static void stressDegenerateTree(int nodeCount, const string &snapshotFile)
+{
+    cout << "Degenerate BST (" << nodeCount << " nodes, UNBALANCED, sorted keys):" << endl;
+    auto keyOf = [](int i)
+    {
+        char key[16];
+        snprintf(key, sizeof(key), "k%08d", i);
+        return string(key);
+    };
+
+    auto start = chrono::steady_clock::now();
+    {
+        WordStore source;
+        source.reserve(nodeCount);
+        for (int i = 0; i < nodeCount; i++)
+        {
+            source.add(Word(keyOf(i), "n.", "stress"));
+        }
+
+        // Node i + 1 holds record i; its only child is the next larger key
+        vector<TreeNode> chain(1, TreeNode(WordStore::INVALID_ID));
+        chain.reserve(static_cast<size_t>(nodeCount) + 1);
+        for (int i = 0; i < nodeCount; i++)
+        {
+            TreeNode node(static_cast<WordId>(i));
+            node.height = nodeCount - i;
+            node.right = (i + 1 < nodeCount) ? static_cast<NodeIndex>(i + 2) : NULL_NODE;
+            chain.push_back(node);
+        }
+
+        SnapshotWriter writer;
+        source.writeSnapshot(writer);
+        writer.addSection(SnapshotSection::TREE_NODES, chain.data(), chain.size() * sizeof(TreeNode), chain.size(),
+                          static_cast<uint64_t>(nodeCount), static_cast<uint64_t>(TreeMode::UNBALANCED));
+        if (!writer.writeFile(snapshotFile, 0))
+        {
+            cout << "  Cannot write " << snapshotFile << endl;
+            return;
+        }
+    }
+
+    WordStore store;
+    unique_ptr<BinaryTree> tree = make_unique<BinaryTree>(store, TreeMode::UNBALANCED);
+    SnapshotReader reader;
+    bool loaded = reader.open(snapshotFile);
+    if (loaded)
+    {
+        uint32_t recordCount = reader.find(SnapshotSection::STORE_RECORDS)->count;
+        loaded = WordStore::checkSnapshot(reader) && tree->checkSnapshot(reader, recordCount);
+    }
+    if (loaded)
+    {
+        reader.attachTo(store);
+        loaded = store.readSnapshot(reader) && tree->readSnapshot(reader);
+    }
+    error_code error;
+    filesystem::remove(snapshotFile, error);
+    if (!loaded)
+    {
+        cout << "  Cannot load " << snapshotFile << endl;
+        return;
+    }
+    printStressStep("build", start, "height " + to_string(tree->getHeight()));
+
+    start = chrono::steady_clock::now();
+    int found = 0;
+    const string probes[] = {keyOf(0), keyOf(nodeCount / 2), keyOf(nodeCount - 1), keyOf(nodeCount)};
+    for (const string &probe : probes)
+    {
+        found += (tree->search(probe) != nullptr) ? 1 : 0;
+    }
+    printStressStep("search first/middle/last/miss", start, to_string(found) + " of 3 hits found");
+
+    start = chrono::steady_clock::now();
+    int visited = 0;
+    bool ordered = true;
+    string_view previous;
+    for (const Word &word : *tree)
+    {
+        ordered = ordered && (visited == 0 || previous < word.getWord());
+        previous = word.getWord();
+        visited++;
+    }
+    printStressStep("in-order walk", start, to_string(visited) + " words" + (ordered ? ", sorted" : ", NOT SORTED"));
+
+    start = chrono::steady_clock::now();
+    long long bytes = tree->getMemoryUsage();
+    printStressStep("memory usage", start, to_string(bytes / (1024 * 1024)) + " MB");
+
+    start = chrono::steady_clock::now();
+    tree.reset();
+    printStressStep("destroy", start, "");
+}
+
+/**
+ * Builds, searches, walks, measures and destroys a Trie whose words are nested
+ * prefixes of one long word, so the Trie is a single path as deep as that word
+ * @param depth: Length of the longest word (and depth of the Trie)
+ */
+static void stressDeepTrie(int depth)
+{
+    const int WORDS = 8; // Nested prefixes of depth / 8, 2 * depth / 8, ..., depth characters
+    cout << "Deep Trie (" << depth << " levels, " << WORDS << " nested words):" << endl;
+
+    string longest(depth, ' ');
+    for (int i = 0; i < depth; i++)
+    {
+        longest[i] = static_cast<char>('a' + (i * 7) % 26);
+    }
+
+    auto start = chrono::steady_clock::now();
+    WordStore store;
+    unique_ptr<Trie> trie = make_unique<Trie>(store);
+    for (int w = 1; w <= WORDS; w++)
+    {
+        trie->insert(store.add(Word(string_view(longest).substr(0, static_cast<size_t>(depth) * w / WORDS), "n.", "stress")));
+    }
+    printStressStep("build", start, to_string(trie->getNodeCount()) + " nodes");
+
+    start = chrono::steady_clock::now();
+    int found = 0;
+    for (int w = 1; w <= WORDS; w++)
+    {
+        found += (trie->search(longest.substr(0, static_cast<size_t>(depth) * w / WORDS)) != nullptr) ? 1 : 0;
+    }
+    bool missed = trie->search(longest + "a") == nullptr;
+    printStressStep("search every word + miss", start,
+                    to_string(found) + " of " + to_string(WORDS) + " found" + (missed ? "" : ", MISS FOUND"));
+
+    start = chrono::steady_clock::now();
+    int listed = trie->forEachWithPrefix("", -1, [](const Word &) {});
+    printStressStep("prefix walk", start, to_string(listed) + " words");
+
+    start = chrono::steady_clock::now();
+    trie->updateMaxWeights();
+    int ranked = trie->forEachTopCompletion("", WORDS, [](const Word &, uint32_t) {});
+    printStressStep("max weights + top-k", start, to_string(ranked) + " words");
+
+    start = chrono::steady_clock::now();
+    DoubleArrayTrie frozen = trie->freeze();
+    bool frozenFound = frozen.search(longest) != nullptr;
+    printStressStep("freeze + frozen search", start, frozenFound ? "found" : "NOT FOUND");
+
+    start = chrono::steady_clock::now();
+    long long bytes = trie->getMemoryUsage();
+    printStressStep("memory usage", start, to_string(bytes / (1024 * 1024)) + " MB");
+
+    start = chrono::steady_clock::now();
+    trie.reset();
+    printStressStep("destroy", start, "");
+}
+
+/**
+ * Runs every BinaryTree and Trie operation on very deep structures from a thread
+ * with a 256 KB stack: a 10M-node degenerate BST and a 1M-level Trie
+ * Any traversal that recursed once per level would overflow that stack long
+ * before the bottom; all of them use heap-allocated stacks or loops instead
+ * @param snapshotFile: Scratch file used to build the degenerate tree
+ */
+void stressTestDeepStructures(const string &snapshotFile)
+{
+    cout << "\n========================================" << endl;
+    cout << "   DEEP STRUCTURES ON A 256 KB STACK" << endl;
+    cout << "========================================" << endl;
+
+    const size_t STACK_BYTES = 256 * 1024;
+    const int TREE_NODES = 10000000;
+    const int TRIE_DEPTH = 1000000;
+
+    bool sized = runWithStackSize(STACK_BYTES, [&snapshotFile, TREE_NODES, TRIE_DEPTH]()
+                                  {
+        stressDegenerateTree(TREE_NODES, snapshotFile);
+        stressDeepTrie(TRIE_DEPTH); });
+    cout << (sized ? "Completed on a thread with a " + to_string(STACK_BYTES / 1024) + " KB stack"
+                   : string("Completed on a default-sized thread stack (stack size not settable here)"))
+         << endl;
+}
+
+// =========================================
+// MEMORY USAGE ANALYSIS
+// =========================================
+
+/**
+ * Displays detailed memory usage information for the record store and both indexes
+ * Word records are stored once and shared, so their payload is reported on its own;
+ * each structure's figure is pure index overhead (nodes, child maps)
+ * Shows node count, total memory in bytes and KB, and percentage comparison
+ * @param store: WordStore holding the shared records
+ * @param tree: BinaryTree to analyze
+ * @param trie: Trie to analyze
+ * @param frozenTrie: Double-array form of the Trie to analyze
+ * @param radix: RadixTrie to analyze
+ * @param dawg: Dawg to analyze
+ * @param hashIndex: HashIndex to analyze
+ */
+void displayMemoryUsage(WordStore &store, BinaryTree &tree, Trie &trie, const DoubleArrayTrie &frozenTrie,
+                        RadixTrie &radix, Dawg &dawg, const HashIndex &hashIndex)
+{
+    cout << "\n========================================" << endl;
+    cout << "         MEMORY USAGE" << endl;
+    cout << "========================================" << endl;
+
+    long long storeMemory = store.getMemoryUsage();
+    long long treeMemory = tree.getMemoryUsage();
+    long long trieMemory = trie.getMemoryUsage();
+    long long frozenMemory = frozenTrie.getMemoryUsage();
+    long long radixMemory = radix.getMemoryUsage();
+    long long dawgMemory = dawg.getMemoryUsage();
+    long long hashMemory = hashIndex.getMemoryUsage();
+
+    cout << "Word records (shared payload):" << endl;
+    cout << "  - Number of records: " << store.size() << endl;
+    cout << "  - Memory used: " << storeMemory << " bytes (~"
+         << (storeMemory / 1024.0) << " KB)" << endl;
+
+    cout << "\nBinary Tree (index overhead):" << endl;
+    cout << "  - Balancing: " << (tree.getMode() == TreeMode::AVL ? "AVL" : "none") << endl;
+    cout << "  - Number of nodes: " << tree.getNodeCount() << endl;
+    cout << "  - Tree height: " << tree.getHeight() << endl;
+    cout << "  - Memory used: " << treeMemory << " bytes (~"
+         << (treeMemory / 1024.0) << " KB)" << endl;
+
+    cout << "\nTrie (index overhead):" << endl;
+    cout << "  - Number of nodes: " << trie.getNodeCount() << endl;
+    cout << "  - Memory used: " << trieMemory << " bytes (~"
+         << (trieMemory / 1024.0) << " KB)" << endl;
+
+    cout << "\nFrozen Trie (double-array, index overhead):" << endl;
+    cout << "  - Number of states: " << frozenTrie.getNodeCount() << endl;
+    cout << "  - Array cells (incl. free): " << frozenTrie.getCellCount() << endl;
+    cout << "  - Memory used: " << frozenMemory << " bytes (~"
+         << (frozenMemory / 1024.0) << " KB)" << endl;
+
+    cout << "\nRadix Trie (index overhead):" << endl;
+    cout << "  - Number of nodes: " << radix.getNodeCount() << endl;
+    cout << "  - Memory used: " << radixMemory << " bytes (~"
+         << (radixMemory / 1024.0) << " KB)" << endl;
+
+    cout << "\nDAWG (index overhead, incl. rank -> record table):" << endl;
+    cout << "  - Number of states: " << dawg.getNodeCount() << endl;
+    cout << "  - Number of edges: " << dawg.getEdgeCount() << endl;
+    cout << "  - Memory used: " << dawgMemory << " bytes (~"
+         << (dawgMemory / 1024.0) << " KB)" << endl;
+
+    cout << "\nHash Index (index overhead):" << endl;
+    cout << "  - Number of keys: " << hashIndex.getKeyCount() << endl;
+    cout << "  - Number of slots: " << hashIndex.getSlotCount() << endl;
+    if (hashIndex.getSlotCount() > 0)
+    {
+        cout << "  - Load factor: " << fixed << setprecision(2)
+             << ((double)hashIndex.getKeyCount() / hashIndex.getSlotCount()) << endl;
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+    }
+    cout << "  - Memory used: " << hashMemory << " bytes (~"
+         << (hashMemory / 1024.0) << " KB)" << endl;
+
+    cout << "\n--- COMPARISON ---" << endl;
+    if (treeMemory < trieMemory)
+    {
+        double percent = ((double)(trieMemory - treeMemory) / trieMemory) * 100;
+        cout << "Binary Tree uses less memory by " << (trieMemory - treeMemory)
+             << " bytes (" << fixed << setprecision(2) << percent << "% )" << endl;
+    }
+    else
+    {
+        double percent = ((double)(treeMemory - trieMemory) / treeMemory) * 100;
         cout << "Trie uses less memory by " << (treeMemory - trieMemory)
              << " bytes (" << fixed << setprecision(2) << percent << "% )" << endl;
     }
+
+    if (trie.getNodeCount() > 0)
+    {
+        double nodePercent = ((double)radix.getNodeCount() / trie.getNodeCount()) * 100;
+        cout << "Radix Trie needs " << fixed << setprecision(2) << nodePercent
+             << "% of the Trie's nodes" << endl;
+    }
+
+    // Bytes per key puts every index on the same scale
+    if (dawg.getKeyCount() > 0)
+    {
+        double keys = dawg.getKeyCount();
+        cout << "Bytes per key: Tree " << fixed << setprecision(2) << (treeMemory / keys)
+             << ", Trie " << (trieMemory / keys)
+             << ", Frozen Trie " << (frozenMemory / keys) << ", Radix " << (radixMemory / keys)
+             << ", DAWG " << (dawgMemory / keys) << ", Hash " << (hashMemory / keys) << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
 }
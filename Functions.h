@@ -1,11 +1,34 @@
 #ifndef FUNCTIONS_H
 #define FUNCTIONS_H
 
+#include "WordStore.h"
 #include "BinaryTree.h"
 #include "Trie.h"
+#include "RadixTrie.h"
+#include "Dawg.h"
+#include "HashIndex.h"
+#include "EytzingerIndex.h"
+#include "DelimiterScanner.h"
+#include "Snapshot.h"
+#include "QueryEngine.h"
+#include "EpochManager.h"
+#include "BenchmarkHarness.h"
+#include "AllocationCounter.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
+#include <random>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -16,13 +39,92 @@
 // =========================================
 
 /**
- * Loads words from a dictionary file into both data structures
+ * Parses every line of a block of dictionary text into Word views
+ * @param text: Block of dictionary text starting at a line boundary
+ * @param entries: Parsed entries are appended here in file order
+ */
+void parseDictionaryText(std::string_view text, std::vector<Word> &entries);
+
+/**
+ * Loads a dictionary file into the record store and both indexes without printing
+ * Parses newline-aligned chunks on N threads, then builds the BST and the Trie
+ * concurrently (Trie partitioned by first character); results match a serial load
+ * @param filename: Path to the dictionary file
+ * @param store: WordStore that will own every record
+ * @param tree: BinaryTree reference to index the records in
+ * @param trie: Trie reference to index the records in
+ * @param threadCount: Number of threads (0 = one per hardware thread, 1 = serial)
+ * @param bytesLoaded: Set to the size of the file in bytes
+ * @return: Number of records loaded, or -1 if the file can't be opened
+ */
+int buildDictionary(const std::string &filename, WordStore &store, BinaryTree &tree, Trie &trie,
+                    int threadCount, size_t &bytesLoaded);
+
+/**
+ * Loads words from a dictionary file into the record store and both indexes
+ * The file is memory-mapped; records are zero-copy views into it
  * File format: Word|PartOfSpeech|Definition (pipe-delimited)
  * @param filename: Path to the dictionary file
- * @param tree: BinaryTree reference to insert words into
- * @param trie: Trie reference to insert words into
+ * @param store: WordStore that will own every record
+ * @param tree: BinaryTree reference to index the records in
+ * @param trie: Trie reference to index the records in
+ * @param threadCount: Number of threads (0 = one per hardware thread, 1 = serial)
+ */
+void loadWords(const std::string &filename, WordStore &store, BinaryTree &tree, Trie &trie,
+               int threadCount = 0);
+
+/**
+ * Loads the dictionary with 1 to 32 threads and prints the scaling curve
+ * Verifies every parallel result against the serial load
+ * @param filename: Path to the dictionary file
+ */
+void benchmarkLoadScaling(const std::string &filename);
+
+/**
+ * Adds popularity weights from a weights file or query log to the store's records
+ * Each line is either "Word|Count" (adds Count) or a bare query "Word" (adds 1),
+ * so a weights table and a raw query log can be used interchangeably
+ * Unknown words are ignored; the Trie's subtree maxima are refreshed afterwards
+ * @param filename: Path to the weights file
+ * @param store: WordStore whose record weights are raised
+ * @param trie: Trie used to find records by word (and kept in sync)
+ * @return: Number of lines applied to a record, or -1 if the file can't be opened
+ */
+int loadWeights(const std::string &filename, WordStore &store, Trie &trie);
+
+// =========================================
+// SNAPSHOT
+// =========================================
+
+/**
+ * Restores the record store, BST, Trie and frozen Trie from a binary snapshot
+ * The snapshot is memory-mapped and used in place; it is rejected (and nothing
+ * is modified) if it is missing, corrupt, from another version or build, or
+ * older or a different size than the dictionary text file, or if any stored
+ * index or record ID is out of range
+ * @param snapshotFile: Path to the snapshot
+ * @param textFile: Path to the dictionary text file it was built from
+ * @param store: Empty WordStore to restore
+ * @param tree: Empty BinaryTree to restore (its mode must match the snapshot)
+ * @param trie: Empty Trie to restore
+ * @param frozenTrie: Empty DoubleArrayTrie to restore
+ * @return: True if the structures were restored
  */
-void loadWords(const std::string &filename, BinaryTree &tree, Trie &trie);
+bool loadSnapshot(const std::string &snapshotFile, const std::string &textFile, WordStore &store,
+                  BinaryTree &tree, Trie &trie, DoubleArrayTrie &frozenTrie);
+
+/**
+ * Writes the record store, BST, Trie and frozen Trie to a binary snapshot
+ * @param snapshotFile: Destination path (replaced atomically)
+ * @param textFile: Path to the dictionary text file the structures were built from
+ * @param store: Loaded WordStore
+ * @param tree: Built BinaryTree
+ * @param trie: Built Trie
+ * @param frozenTrie: Frozen copy of the Trie
+ * @return: True on success
+ */
+bool saveSnapshot(const std::string &snapshotFile, const std::string &textFile, const WordStore &store,
+                  const BinaryTree &tree, const Trie &trie, const DoubleArrayTrie &frozenTrie);
 
 // =========================================
 // USER INTERFACE
@@ -39,37 +141,205 @@ void displayMenu();
 // =========================================
 
 /**
- * Prompts user for a word and searches in both data structures
- * Displays results and timing comparison for both BST and Trie
+ * Prompts user for a word and searches in the exact-lookup structures
+ * Displays results and timing comparison for the BST, Trie and hash index;
+ * on a miss, suggests the closest words from the Trie
  * @param tree: BinaryTree to search in
- * @param trie: Trie to search in
+ * @param trie: Frozen (double-array) Trie to search in
+ * @param hashIndex: HashIndex to search in
+ * @param suggestions: Trie used for fuzzy suggestions
+ */
+void searchWord(BinaryTree &tree, const DoubleArrayTrie &trie, const HashIndex &hashIndex, const Trie &suggestions);
+
+/**
+ * Prints the words within an edit distance of a query, closest first
+ * @param trie: Trie to search
+ * @param word: Query word (case-insensitive)
+ * @param maxEdits: Maximum Levenshtein distance
+ * @param limit: Maximum number of words to print (negative = unlimited)
+ * @return: Number of words printed
+ */
+int printFuzzyMatches(const Trie &trie, const std::string &word, int maxEdits, int limit);
+
+/**
+ * Prints the words starting with a prefix in lexicographic order, one per line
+ * @param trie: Trie to enumerate
+ * @param prefix: Prefix to match (case-insensitive)
+ * @param limit: Maximum number of words to print (negative = unlimited)
+ * @return: Number of words printed
+ */
+int printPrefixMatches(const Trie &trie, const std::string &prefix, int limit);
+
+/**
+ * Prompts user for a prefix and a result limit and lists the matching words
+ * Reports the enumeration time
+ * @param trie: Trie to enumerate
+ */
+void prefixSearch(const Trie &trie);
+
+/**
+ * Prints the k heaviest words starting with a prefix with their weights, heaviest first
+ * @param trie: Trie to search
+ * @param prefix: Prefix to match (case-insensitive)
+ * @param k: Maximum number of words to print (negative = unlimited)
+ * @return: Number of words printed
  */
-void searchWord(BinaryTree &tree, Trie &trie);
+int printTopCompletions(const Trie &trie, const std::string &prefix, int k);
+
+/**
+ * Prompts user for a prefix and k and lists the top-k completions by weight
+ * Reports the search time
+ * @param trie: Trie to search
+ */
+void autocomplete(const Trie &trie);
+
+/**
+ * Prints the words matching a wildcard pattern in alphabetical order, one per line
+ * Notes when the node budget stopped the search early
+ * @param trie: Trie to search
+ * @param pattern: Pattern with '?' (any one character) and '*' (any run)
+ * @param limit: Maximum number of words to print (negative = unlimited)
+ * @param nodeBudget: Maximum number of trie nodes to visit (negative = unlimited)
+ * @return: Number of words printed
+ */
+int printPatternMatches(const Trie &trie, const std::string &pattern, int limit, long long nodeBudget);
+
+/**
+ * Prompts user for a wildcard pattern and a result limit and lists the matches
+ * Reports the search time
+ * @param trie: Trie to search
+ * @param nodeBudget: Maximum number of trie nodes to visit per query
+ */
+void patternSearch(const Trie &trie, long long nodeBudget);
+
+/**
+ * Prints the words in [lo, hi] in alphabetical order, one per line
+ * @param index: Static ordered index to walk (same order as the BinaryTree)
+ * @param lo: Smallest word to include (case-sensitive)
+ * @param hi: Largest word to include (case-sensitive)
+ * @param limit: Maximum number of words to print (negative = unlimited)
+ * @return: Number of words printed
+ */
+int printWordRange(const EytzingerIndex &index, const std::string &lo, const std::string &hi, int limit);
+
+/**
+ * Prompts user for a starting word and a page size and pages through the
+ * dictionary alphabetically from there ("next N words after X")
+ * @param index: Static ordered index to walk (same order as the BinaryTree)
+ */
+void browseWords(const EytzingerIndex &index);
 
 // =========================================
 // PERFORMANCE COMPARISON
 // =========================================
 
 /**
- * Runs a batch of test searches and compares performance
- * Measures and displays search times for each structure
- * Calculates averages and determines which structure is faster
+ * Compares the lookup speed of every structure with a BenchmarkHarness
+ * Uniform and Zipfian hit and miss workloads drawn from the whole dictionary,
+ * warmup, thousands of timed iterations per key and calibrated timer overhead;
+ * prints min/median/p99 with confidence intervals and optionally writes JSON
+ * @param store: WordStore the workloads are drawn from
  * @param tree: BinaryTree to test
  * @param trie: Trie to test
- * @param testCases: Vector of words to search for
+ * @param frozenTrie: Double-array form of the Trie to test
+ * @param radix: RadixTrie (path-compressed Trie) to test
+ * @param dawg: Dawg (minimized automaton) to test
+ * @param hashIndex: HashIndex (exact match only) to test
+ * @param jsonFile: Where to write the results as JSON ("" = don't write)
+ */
+void comparePerformance(const WordStore &store, const BinaryTree &tree, const Trie &trie,
+                        const DoubleArrayTrie &frozenTrie, const RadixTrie &radix, const Dawg &dawg,
+                        const HashIndex &hashIndex, const std::string &jsonFile);
+
+/**
+ * Compares one-at-a-time lookups with batched (interleaved) lookups
+ * Looks up every word in shuffled order with batch sizes 1, 8, 32 and 128 and
+ * prints throughput, speedup over the serial loop, and whether results match
+ * @param tree: BinaryTree to test
+ * @param trie: Trie to test
+ * @param store: WordStore whose words are used as keys
+ */
+void benchmarkBatchLookup(const BinaryTree &tree, const Trie &trie, const WordStore &store);
+
+/**
+ * Measures multi-threaded query throughput with a QueryEngine
+ * Answers every word from 1 to N worker threads (N = hardware threads) and
+ * prints aggregate QPS (median of untimed runs after a warmup), sampled
+ * p50/p99 latency, speedup and whether results match
+ * @param tree: BinaryTree to serve
+ * @param trie: Trie to serve
+ * @param frozenTrie: Frozen (double-array) Trie to serve
+ * @param store: WordStore whose words are used as keys
+ */
+void benchmarkQueryThroughput(const BinaryTree &tree, const Trie &trie, const DoubleArrayTrie &frozenTrie,
+                              const WordStore &store);
+
+/**
+ * Stress-tests concurrent mode on a freshly loaded dictionary
+ * Reader threads search the BST and Trie without locks while one writer adds
+ * 20,000 words and corrects existing definitions; prints reads/s, writes/s,
+ * wrong or missing read results (must be 0) and whether every update landed
+ * @param filename: Path to the dictionary file
+ */
+void benchmarkConcurrentUpdates(const std::string &filename);
+
+/**
+ * Compares BinaryTree::search with the static Eytzinger index built from it
+ * Runs on the loaded dictionary, then on random keys from 10k to 10M words;
+ * prints ns per lookup, speedup, bytes per key and whether lookups, bounds and
+ * ordered iteration match the tree
+ * @param tree: BinaryTree holding the dictionary
+ * @param index: EytzingerIndex built from the tree
+ * @param store: WordStore whose words are used as keys
+ */
+void benchmarkOrderedIndex(const BinaryTree &tree, const EytzingerIndex &index, const WordStore &store);
+
+// =========================================
+// ALLOCATION COUNTING
+// =========================================
+
+/**
+ * Counts global operator new calls around every lookup of BinaryTree, Trie,
+ * DoubleArrayTrie and HashIndex (all zero: keys are compared in place), next to a
+ * control that copies each found definition into a std::string
+ * Only available in builds compiled with COUNT_ALLOCATIONS; otherwise says so
+ * @param tree: BinaryTree to test
+ * @param trie: Trie to test
+ * @param frozenTrie: Frozen (double-array) Trie to test
+ * @param hashIndex: HashIndex to test
+ * @param store: WordStore whose words are used as keys
+ */
+void benchmarkLookupAllocations(const BinaryTree &tree, const Trie &trie, const DoubleArrayTrie &frozenTrie,
+                                const HashIndex &hashIndex, const WordStore &store);
+
+// =========================================
+// STACK-SAFETY STRESS TEST
+// =========================================
+
+/**
+ * Runs searches, walks, memory accounting and teardown on a 10M-node degenerate
+ * BST and a 1M-level Trie, from a thread with a 256 KB stack
+ * @param snapshotFile: Scratch file used to build the degenerate tree (removed again)
  */
-void comparePerformance(BinaryTree &tree, Trie &trie, const std::vector<std::string> &testCases);
+void stressTestDeepStructures(const std::string &snapshotFile);
 
 // =========================================
 // MEMORY ANALYSIS
 // =========================================
 
 /**
- * Displays memory usage information for both data structures
- * Shows node count, total memory used, and percentage comparison
+ * Displays memory usage information for the record store and both indexes
+ * Shows record payload separately from per-index overhead, node counts,
+ * and a percentage comparison of the two indexes
+ * @param store: WordStore holding the shared records
  * @param tree: BinaryTree to analyze
  * @param trie: Trie to analyze
+ * @param frozenTrie: Double-array form of the Trie to analyze
+ * @param radix: RadixTrie to analyze
+ * @param dawg: Dawg to analyze
+ * @param hashIndex: HashIndex to analyze
  */
-void displayMemoryUsage(BinaryTree &tree, Trie &trie);
+void displayMemoryUsage(WordStore &store, BinaryTree &tree, Trie &trie, const DoubleArrayTrie &frozenTrie,
+                        RadixTrie &radix, Dawg &dawg, const HashIndex &hashIndex);
 
 #endif
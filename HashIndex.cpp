@@ -0,0 +1,351 @@
+#include "HashIndex.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// =========================================
+// HASHING
+// =========================================
+
+/**
+ * Lowercases the ASCII letters of 8 bytes at once
+ * A byte is an uppercase letter if its low 7 bits are in 'A'..'Z' and its high bit
+ * is clear; adding offsets to the 7-bit values sets bit 7 without carrying into
+ * the next byte, and 0x80 >> 2 is exactly the 0x20 that lowercases a letter
+ * @param block: 8 bytes of text
+ * @return: The bytes with 'A'..'Z' replaced by 'a'..'z'
+ */
+static inline uint64_t foldBlock(uint64_t block)
+{
+    const uint64_t ONES = 0x0101010101010101ULL;
+    uint64_t low7 = block & (0x7F * ONES);
+    uint64_t atLeastA = low7 + (0x80 - 'A') * ONES;   // Bit 7 set where the byte is >= 'A'
+    uint64_t aboveZ = low7 + (0x80 - 'Z' - 1) * ONES; // Bit 7 set where the byte is > 'Z'
+    uint64_t upper = atLeastA & ~aboveZ & ~block & (0x80 * ONES);
+    return block | (upper >> 2);
+}
+
+/**
+ * Lowercases one ASCII letter (the C-locale tolower that Trie relies on)
+ * @param c: Character
+ * @return: Lowercase character
+ */
+static inline char foldChar(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+/**
+ * Index of the lowest set bit of a non-zero mask
+ * @param mask: Bit mask (not 0)
+ * @return: Bit index
+ */
+static inline unsigned lowestBit(unsigned mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * Hashes a word case-insensitively, 8 folded bytes per multiply
+ * The low 7 bits become the control byte, the bits above them pick the first
+ * group and the high 32 bits are kept in the slot, so the final step mixes
+ * every input bit into all of them
+ * @param text: Word to hash
+ * @return: 64-bit hash
+ */
+uint64_t HashIndex::hashOf(std::string_view text)
+{
+    uint64_t hash = text.size() * 0x9E3779B97F4A7C15ULL;
+    size_t position = 0;
+
+    while (position < text.size())
+    {
+        uint64_t block = 0;
+        std::memcpy(&block, text.data() + position, std::min<size_t>(8, text.size() - position));
+        hash = (hash ^ foldBlock(block)) * 0xBF58476D1CE4E5B9ULL;
+        hash ^= hash >> 31;
+        position += 8;
+    }
+
+    hash ^= hash >> 32;
+    hash *= 0xD6E8FEB86659FD93ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/**
+ * Compares two words case-insensitively
+ * @param a: First word
+ * @param b: Second word
+ * @return: True if they are equal after folding
+ */
+bool HashIndex::equalsIgnoreCase(std::string_view a, std::string_view b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (foldChar(a[i]) != foldChar(b[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =========================================
+// CONSTRUCTOR
+// =========================================
+
+/**
+ * Constructor - the table is allocated on the first insert
+ * @param store: Record store holding the words (must outlive the index)
+ */
+HashIndex::HashIndex(const WordStore &store)
+    : store(&store), groupMask(0), keyCount(0)
+{
+}
+
+// =========================================
+// PROBING
+// =========================================
+
+/**
+ * Finds the slot holding a word
+ * Probes whole groups in triangular order (group, +1, +3, +6, ...), which visits
+ * every group of a power-of-two table. In each group, one compare finds the
+ * slots whose control byte equals the hash's low 7 bits; only those are checked
+ * against the stored hash and then the word itself. A group with a free slot
+ * ends the search, since an insert would have stopped there
+ * @param text: Word to find
+ * @param hash: hashOf(text)
+ * @return: Slot index, or -1 if the word is not indexed
+ */
+long long HashIndex::findSlot(std::string_view text, uint64_t hash) const
+{
+    if (slots.empty())
+    {
+        return -1;
+    }
+
+    int8_t tag = static_cast<int8_t>(hash & 0x7F);
+    uint32_t check = static_cast<uint32_t>(hash >> 32);
+    size_t group = (hash >> 7) & groupMask;
+
+    for (size_t step = 1;; step++)
+    {
+        size_t first = group * GROUP_SIZE;
+        const int8_t *bytes = control.data() + first;
+
+#if defined(__SSE2__) || defined(_M_X64)
+        __m128i group16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes));
+        unsigned matches = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(group16, _mm_set1_epi8(tag))));
+        unsigned empties = static_cast<unsigned>(_mm_movemask_epi8(group16)); // Only EMPTY has bit 7 set
+#else
+        unsigned matches = 0;
+        unsigned empties = 0;
+        for (int i = 0; i < GROUP_SIZE; i++)
+        {
+            matches |= (bytes[i] == tag) ? (1u << i) : 0;
+            empties |= (bytes[i] == EMPTY) ? (1u << i) : 0;
+        }
+#endif
+
+        while (matches != 0)
+        {
+            size_t index = first + lowestBit(matches);
+            const HashSlot &slot = slots[index];
+            if (slot.hash == check && equalsIgnoreCase(store->get(slot.id).getWord(), text))
+            {
+                return static_cast<long long>(index);
+            }
+            matches &= matches - 1;
+        }
+
+        if (empties != 0)
+        {
+            return -1;
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+/**
+ * Stores an entry in the first free slot of its probe sequence
+ * The load factor stays at or below 7/8, so a free slot always exists
+ * @param hash: Hash of the word
+ * @param id: Record ID of the word
+ */
+void HashIndex::place(uint64_t hash, WordId id)
+{
+    size_t group = (hash >> 7) & groupMask;
+
+    for (size_t step = 1;; step++)
+    {
+        size_t first = group * GROUP_SIZE;
+        for (int i = 0; i < GROUP_SIZE; i++)
+        {
+            if (control[first + i] == EMPTY)
+            {
+                control[first + i] = static_cast<int8_t>(hash & 0x7F);
+                slots[first + i] = HashSlot{static_cast<uint32_t>(hash >> 32), id};
+                return;
+            }
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+/**
+ * Reallocates the table and reinserts every entry
+ * Slots keep only part of the hash, so each word is hashed again
+ * @param groupCount: New group count (power of two)
+ */
+void HashIndex::rehash(size_t groupCount)
+{
+    std::vector<int8_t> oldControl;
+    std::vector<HashSlot> oldSlots;
+    oldControl.swap(control);
+    oldSlots.swap(slots);
+
+    control.assign(groupCount * GROUP_SIZE, EMPTY);
+    slots.assign(groupCount * GROUP_SIZE, HashSlot{0, WordStore::INVALID_ID});
+    groupMask = groupCount - 1;
+
+    for (size_t i = 0; i < oldSlots.size(); i++)
+    {
+        if (oldControl[i] != EMPTY)
+        {
+            place(hashOf(store->get(oldSlots[i].id).getWord()), oldSlots[i].id);
+        }
+    }
+}
+
+// =========================================
+// MAIN OPERATIONS
+// =========================================
+
+/**
+ * Indexes a word
+ * A word already present (ignoring case) gets the new ID, so the index answers
+ * with the same record as the Trie; otherwise the table doubles first if the
+ * new entry would push the load factor over 7/8
+ * @param id: Record ID of the word in the WordStore
+ */
+void HashIndex::insert(WordId id)
+{
+    std::string_view word = store->get(id).getWord();
+    uint64_t hash = hashOf(word);
+
+    long long existing = findSlot(word, hash);
+    if (existing >= 0)
+    {
+        slots[existing].id = id;
+        return;
+    }
+
+    if ((static_cast<size_t>(keyCount) + 1) * 8 > slots.size() * 7)
+    {
+        rehash(slots.empty() ? 1 : (groupMask + 1) * 2);
+    }
+    place(hash, id);
+    keyCount++;
+}
+
+/**
+ * Indexes every record currently in the WordStore, in ID order
+ * The table is sized for all of them first, so inserting never rehashes
+ */
+void HashIndex::indexAll()
+{
+    size_t needed = static_cast<size_t>(keyCount) + store->size();
+    size_t groupCount = 1;
+    while (groupCount * GROUP_SIZE * 7 < needed * 8)
+    {
+        groupCount *= 2;
+    }
+    if (groupCount * GROUP_SIZE > slots.size())
+    {
+        rehash(groupCount);
+    }
+
+    for (int id = 0; id < store->size(); id++)
+    {
+        insert(static_cast<WordId>(id));
+    }
+}
+
+/**
+ * Searches for a word (case-insensitive)
+ * @param name: Word to search for
+ * @return: Pointer to the Word record if found, nullptr otherwise
+ */
+const Word *HashIndex::search(const std::string &name) const
+{
+    long long index = findSlot(name, hashOf(name));
+    return (index >= 0) ? &store->get(slots[index].id) : nullptr;
+}
+
+// =========================================
+// PERFORMANCE MEASUREMENT
+// =========================================
+
+/**
+ * Searches for a word and measures the time taken
+ * @param name: The word to search for
+ * @param result: Reference parameter to store the search result
+ * @return: Time taken for the search in nanoseconds
+ */
+long long HashIndex::searchWithTiming(const std::string &name, const Word *&result) const
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    result = search(name);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// =========================================
+// MEMORY USAGE CALCULATION
+// =========================================
+
+/**
+ * Calculates the memory used by the index
+ * Includes: one control byte and one (hash, record ID) slot per table position
+ * @return: Total memory in bytes
+ */
+long long HashIndex::getMemoryUsage() const
+{
+    return static_cast<long long>(sizeof(HashIndex) + control.capacity() * sizeof(int8_t) +
+                                  slots.capacity() * sizeof(HashSlot));
+}
+
+/**
+ * Returns the number of distinct words indexed
+ * @return: Key count
+ */
+int HashIndex::getKeyCount() const
+{
+    return keyCount;
+}
+
+/**
+ * Returns the number of table slots
+ * @return: Slot count
+ */
+int HashIndex::getSlotCount() const
+{
+    return static_cast<int>(slots.size());
+}
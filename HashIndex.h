@@ -0,0 +1,140 @@
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+
+#include "WordStore.h"
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * HashIndex - Open-addressing hash table over the headwords (Swiss-table layout)
+ * Slots are grouped by 16; each slot has a one-byte control entry holding 7 bits
+ * of the key's hash (or EMPTY). A probe compares a whole group of control bytes
+ * with the query's 7 bits in one SSE2 instruction, so a lookup usually touches
+ * one control line and one slot before verifying the word in the WordStore
+ * Slots store (hash, record ID) pairs, never the key itself
+ * Exact match only, with the same case-insensitive semantics as Trie
+ * Time Complexity: O(m) to hash the word, then O(1) expected probes
+ */
+class HashIndex
+{
+public:
+    static const int GROUP_SIZE = 16; // Slots probed together (one SSE2 register of control bytes)
+
+private:
+    /**
+     * HashSlot - One entry of the table
+     */
+    struct HashSlot
+    {
+        uint32_t hash; // High 32 bits of the word's hash (filters false control matches)
+        WordId id;     // Record ID in the WordStore
+    };
+
+    static constexpr int8_t EMPTY = -128; // Control byte of a free slot (full slots are 0..127)
+
+    const WordStore *store;      // Shared record store that slot IDs refer to
+    std::vector<int8_t> control; // One control byte per slot, GROUP_SIZE-aligned groups
+    std::vector<HashSlot> slots; // Entries, parallel to control
+    size_t groupMask;            // Group count - 1 (the group count is a power of two)
+    int keyCount;                // Distinct words indexed
+
+    // === PRIVATE HELPER FUNCTIONS ===
+
+    /**
+     * Hashes a word case-insensitively (ASCII letters folded, like Trie's tolower)
+     * @param text: Word to hash
+     * @return: 64-bit hash
+     */
+    static uint64_t hashOf(std::string_view text);
+
+    /**
+     * Compares two words case-insensitively
+     * @param a: First word
+     * @param b: Second word
+     * @return: True if they are equal after folding
+     */
+    static bool equalsIgnoreCase(std::string_view a, std::string_view b);
+
+    /**
+     * Finds the slot holding a word
+     * @param text: Word to find
+     * @param hash: hashOf(text)
+     * @return: Slot index, or -1 if the word is not indexed
+     */
+    long long findSlot(std::string_view text, uint64_t hash) const;
+
+    /**
+     * Stores an entry in the first free slot of its probe sequence (no duplicate check)
+     * @param hash: Hash of the word
+     * @param id: Record ID of the word
+     */
+    void place(uint64_t hash, WordId id);
+
+    /**
+     * Reallocates the table with a new number of groups and reinserts every entry
+     * @param groupCount: New group count (power of two)
+     */
+    void rehash(size_t groupCount);
+
+public:
+    // === CONSTRUCTOR ===
+
+    /**
+     * Constructor for an empty index
+     * @param store: Record store holding the words (must outlive the index)
+     */
+    HashIndex(const WordStore &store);
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Indexes a word; a later duplicate replaces the ID (like Trie::insert)
+     * @param id: Record ID of the word in the WordStore
+     */
+    void insert(WordId id);
+
+    /**
+     * Indexes every record currently in the WordStore, in ID order
+     * Sizes the table once up front, so no rehashing happens on the way
+     */
+    void indexAll();
+
+    /**
+     * Searches for a word (case-insensitive, like Trie::search)
+     * @param name: Word to search for
+     * @return: Pointer to the Word record if found, nullptr otherwise
+     */
+    const Word *search(const std::string &name) const;
+
+    // === PERFORMANCE METRICS ===
+
+    /**
+     * Searches for a word and measures execution time
+     * @param name: Word to search for
+     * @param result: Reference parameter to store search result
+     * @return: Search time in nanoseconds
+     */
+    long long searchWithTiming(const std::string &name, const Word *&result) const;
+
+    /**
+     * Gets the memory used by the control bytes and slots
+     * @return: Memory used in bytes
+     */
+    long long getMemoryUsage() const;
+
+    /**
+     * Gets the number of distinct words indexed
+     * @return: Key count
+     */
+    int getKeyCount() const;
+
+    /**
+     * Gets the number of slots (used and free)
+     * @return: Slot count
+     */
+    int getSlotCount() const;
+};
+
+#endif
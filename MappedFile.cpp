@@ -0,0 +1,167 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =========================================
+// CONSTRUCTOR & DESTRUCTOR
+// =========================================
+
+/**
+ * MappedFile Constructor
+ * Creates an empty (unmapped) file view
+ */
+MappedFile::MappedFile() : data(nullptr), length(0), mapped(false), writable(false) {}
+
+/**
+ * MappedFile Destructor
+ * Releases the mapping or buffer
+ */
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+// =========================================
+// MAIN OPERATIONS
+// =========================================
+
+/**
+ * Maps a file into memory
+ * POSIX: mmap the whole file read-only and hint sequential access for the parser;
+ *        copy-on-write mappings (used for snapshots) are writable and hint random access
+ * Windows: read the whole file into one heap buffer with a single read call
+ * @param filename: Path of the file to map
+ * @param copyOnWrite: Map privately writable (changes stay in memory) for random access
+ * @return: True on success, false if the file can't be opened or mapped
+ */
+bool MappedFile::open(const std::string &filename, bool copyOnWrite)
+{
+    close();
+
+#ifdef _WIN32
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::streamsize fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    char *buffer = new char[fileSize > 0 ? fileSize : 1];
+    if (!file.read(buffer, fileSize))
+    {
+        delete[] buffer;
+        return false;
+    }
+
+    data = buffer;
+    length = static_cast<size_t>(fileSize);
+    mapped = false;
+    writable = copyOnWrite;
+    return true;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0)
+    {
+        // mmap rejects zero-length mappings; an empty file is simply empty
+        ::close(fd);
+        data = "";
+        mapped = false;
+        return true;
+    }
+
+    int protection = copyOnWrite ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *address = mmap(nullptr, length, protection, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps its own reference to the file
+
+    if (address == MAP_FAILED)
+    {
+        length = 0;
+        return false;
+    }
+
+    madvise(address, length, copyOnWrite ? MADV_RANDOM : MADV_SEQUENTIAL);
+    data = static_cast<const char *>(address);
+    mapped = true;
+    writable = copyOnWrite;
+    return true;
+#endif
+}
+
+/**
+ * Unmaps the file or frees the buffer
+ */
+void MappedFile::close()
+{
+    if (data == nullptr)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    delete[] data;
+#else
+    if (mapped)
+    {
+        munmap(const_cast<char *>(data), length);
+    }
+#endif
+
+    data = nullptr;
+    length = 0;
+    mapped = false;
+    writable = false;
+}
+
+// =========================================
+// GETTERS
+// =========================================
+
+/**
+ * Returns the file contents
+ * @return: Pointer to the first byte, or nullptr if nothing is mapped
+ */
+const char *MappedFile::getData() const
+{
+    return data;
+}
+
+/**
+ * Returns the file contents for in-memory modification
+ * Safe because the mapping is private (or a heap buffer): the file itself never changes
+ * @return: Pointer to the first byte, or nullptr unless opened copy-on-write
+ */
+char *MappedFile::getWritableData() const
+{
+    return writable ? const_cast<char *>(data) : nullptr;
+}
+
+/**
+ * Returns the file size
+ * @return: Size in bytes
+ */
+size_t MappedFile::getSize() const
+{
+    return length;
+}
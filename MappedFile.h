@@ -0,0 +1,66 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * MappedFile - Read-only view of a whole file in memory
+ * Uses mmap on POSIX systems so the file is paged in on demand with no copy;
+ * on Windows the file is read into a single buffer instead
+ * A copy-on-write mapping may be modified in memory without touching the file
+ * Non-copyable: the mapping is released by the destructor
+ */
+class MappedFile
+{
+private:
+    const char *data; // First byte of the file contents (nullptr if not open)
+    size_t length;    // File size in bytes
+    bool mapped;      // True if data came from mmap, false if it is a heap buffer
+    bool writable;    // True if the contents may be modified in memory
+
+public:
+    // === CONSTRUCTOR & DESTRUCTOR ===
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Maps a file into memory
+     * @param filename: Path of the file to map
+     * @param copyOnWrite: Map privately writable (changes stay in memory) for random access
+     * @return: True on success, false if the file can't be opened or mapped
+     */
+    bool open(const std::string &filename, bool copyOnWrite = false);
+
+    /**
+     * Unmaps the file (no-op if nothing is mapped)
+     */
+    void close();
+
+    // === GETTERS ===
+
+    /**
+     * Gets the file contents
+     * @return: Pointer to the first byte (valid until close())
+     */
+    const char *getData() const;
+
+    /**
+     * Gets the file contents for in-memory modification
+     * @return: Pointer to the first byte, or nullptr unless opened copy-on-write
+     */
+    char *getWritableData() const;
+
+    /**
+     * Gets the file size
+     * @return: Size in bytes
+     */
+    size_t getSize() const;
+};
+
+#endif
@@ -0,0 +1,360 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+/**
+ * NodeIndex - 32-bit handle of an object inside a NodePool
+ * Half the size of a pointer; index 0 is never handed out and means "no node"
+ */
+typedef uint32_t NodeIndex;
+
+static constexpr NodeIndex NULL_NODE = 0;
+
+/**
+ * Hints the CPU to start loading the cache line holding an address
+ * Lets batched lookups overlap the cache misses of independent keys
+ * @param address: Any address (never dereferenced)
+ */
+inline void prefetchLine(const void *address)
+{
+#if defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+    __builtin_prefetch(address);
+#endif
+}
+
+/**
+ * NodePool - Per-structure slab arena addressed by 32-bit indices
+ * Objects live in fixed-size chunks that never move, so references stay
+ * valid while the pool grows. Allocation is a bump of a Cursor; several
+ * threads can allocate at once, each through its own Cursor, and only
+ * claiming a fresh chunk takes a lock. Nothing is freed individually:
+ * the destructor releases whole chunks, O(chunks) instead of O(nodes)
+ * Structures that unlink objects while readers run can hand them back with
+ * recycle() once it is safe (see EpochManager); they are reused by the same cursor
+ * Indices are position-independent, so a dense array saved to disk can be
+ * adopted back as the first chunks with no fix-ups (see adopt())
+ * Optionally backs chunks with transparent huge pages (Linux only)
+ * @tparam T: Trivially destructible object type
+ * @tparam CHUNK_SHIFT: log2 of the objects per chunk
+ */
+template <typename T, int CHUNK_SHIFT = 16>
+class NodePool
+{
+    static_assert(std::is_trivially_destructible<T>::value, "NodePool never runs destructors");
+
+public:
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_SHIFT;              // Objects per chunk
+    static constexpr uint32_t MAX_CHUNKS = (1u << (32 - CHUNK_SHIFT)) - 1; // Chunks addressable by 32 bits
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;              // Granularity for huge-page chunks
+
+    /**
+     * Cursor - Bump position inside the chunk a thread is filling
+     * Owned by the structure, one per allocating thread; a default Cursor claims
+     * a chunk on first use
+     */
+    struct Cursor
+    {
+        NodeIndex next = 0;                        // Next free index
+        NodeIndex end = 0;                         // One past the last index of the current chunk
+        std::vector<std::vector<NodeIndex>> freed; // Recycled runs by length (freed[n] holds runs of n)
+    };
+
+private:
+    std::unique_ptr<T *[]> chunkTable;  // Chunk base pointers (first getChunkCount() are valid)
+    std::atomic<uint32_t> chunkCount;   // Number of claimed chunks
+    uint32_t externalChunks;            // Leading chunks that view adopted memory (never freed)
+    size_t externalBytes;               // Bytes of adopted memory
+    std::mutex chunkMutex;              // Serializes chunk claims
+    bool hugePages;                     // Back chunks with huge pages where supported
+
+    /**
+     * Bytes reserved for one chunk
+     * @return: Chunk size, rounded up to whole huge pages when they are used
+     */
+    size_t chunkBytes() const
+    {
+        size_t bytes = static_cast<size_t>(CHUNK_SIZE) * sizeof(T);
+        if (hugePages)
+        {
+            bytes = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+        return bytes;
+    }
+
+    /**
+     * Claims a fresh chunk and points a cursor at it
+     * Index 0 (start of chunk 0) is skipped so it can mean "no node"
+     * @param cursor: Cursor to refill
+     */
+    void claimChunk(Cursor &cursor)
+    {
+        std::lock_guard<std::mutex> lock(chunkMutex);
+        uint32_t chunk = chunkCount.load(std::memory_order_relaxed);
+        if (chunk == MAX_CHUNKS)
+        {
+            throw std::bad_alloc();
+        }
+
+        void *memory = nullptr;
+#ifndef _WIN32
+        if (hugePages)
+        {
+            memory = mmap(nullptr, chunkBytes(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+#ifdef MADV_HUGEPAGE
+            madvise(memory, chunkBytes(), MADV_HUGEPAGE);
+#endif
+        }
+        else
+#endif
+        {
+            memory = ::operator new(chunkBytes());
+        }
+
+        chunkTable[chunk] = static_cast<T *>(memory);
+        chunkCount.store(chunk + 1, std::memory_order_release);
+
+        cursor.next = (chunk == 0) ? 1 : (chunk << CHUNK_SHIFT);
+        cursor.end = (chunk << CHUNK_SHIFT) + CHUNK_SIZE;
+    }
+
+    /**
+     * Pops a recycled run of exactly the requested length
+     * @param cursor: Calling thread's cursor
+     * @param count: Run length
+     * @return: First index of the run, or NULL_NODE if none was recycled
+     */
+    static NodeIndex takeFreed(Cursor &cursor, uint32_t count)
+    {
+        if (count >= cursor.freed.size() || cursor.freed[count].empty())
+        {
+            return NULL_NODE;
+        }
+        NodeIndex first = cursor.freed[count].back();
+        cursor.freed[count].pop_back();
+        return first;
+    }
+
+    /**
+     * Releases every chunk
+     */
+    void releaseChunks()
+    {
+        uint32_t count = chunkCount.load(std::memory_order_acquire);
+        for (uint32_t chunk = externalChunks; chunk < count; chunk++)
+        {
+#ifndef _WIN32
+            if (hugePages)
+            {
+                munmap(chunkTable[chunk], chunkBytes());
+                continue;
+            }
+#endif
+            ::operator delete(chunkTable[chunk]);
+        }
+        chunkCount.store(0, std::memory_order_release);
+        externalChunks = 0;
+        externalBytes = 0;
+    }
+
+public:
+    // === CONSTRUCTOR & DESTRUCTOR ===
+
+    /**
+     * Constructor
+     * The chunk table is reserved up front so it never moves under concurrent readers
+     * @param hugePages: Back chunks with transparent huge pages (ignored off Linux)
+     */
+    explicit NodePool(bool hugePages = false)
+        : chunkTable(new T *[MAX_CHUNKS]), chunkCount(0), externalChunks(0), externalBytes(0),
+          hugePages(hugePages) {}
+
+    /**
+     * Destructor - Releases all chunks at once
+     */
+    ~NodePool()
+    {
+        releaseChunks();
+    }
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    // === ALLOCATION ===
+
+    /**
+     * Constructs one object through a cursor
+     * @param cursor: Calling thread's cursor
+     * @param args: Constructor arguments
+     * @return: Index of the new object
+     */
+    template <typename... Args>
+    NodeIndex create(Cursor &cursor, Args &&...args)
+    {
+        NodeIndex index = takeFreed(cursor, 1);
+        if (index == NULL_NODE)
+        {
+            if (cursor.next == cursor.end)
+            {
+                claimChunk(cursor);
+            }
+            index = cursor.next++;
+        }
+        new (&get(index)) T(std::forward<Args>(args)...);
+        return index;
+    }
+
+    /**
+     * Allocates a run of contiguous, value-initialized objects within one chunk
+     * The rest of the current chunk is abandoned if the run does not fit
+     * @param cursor: Calling thread's cursor
+     * @param count: Number of objects (at most CHUNK_SIZE - 1)
+     * @return: Index of the first object of the run
+     */
+    NodeIndex createRun(Cursor &cursor, uint32_t count)
+    {
+        NodeIndex first = takeFreed(cursor, count);
+        if (first == NULL_NODE)
+        {
+            if (cursor.end - cursor.next < count)
+            {
+                claimChunk(cursor);
+            }
+            first = cursor.next;
+            cursor.next += count;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            new (&get(first + i)) T();
+        }
+        return first;
+    }
+
+    /**
+     * Hands a run back for reuse by create()/createRun() through a cursor
+     * Only call once no reader can reach the run any more
+     * @param cursor: Cursor that will reuse the run
+     * @param first: First index of the run
+     * @param count: Length the run was created with
+     */
+    void recycle(Cursor &cursor, NodeIndex first, uint32_t count)
+    {
+        if (cursor.freed.size() <= count)
+        {
+            cursor.freed.resize(count + 1);
+        }
+        cursor.freed[count].push_back(first);
+    }
+
+    /**
+     * Makes an external dense array the contents of an empty pool
+     * Element i becomes index i (element 0 is the unused NULL_NODE slot); the
+     * array is split into chunk-sized views, so nothing is copied or fixed up.
+     * Later allocations go to new chunks; the array must outlive the pool
+     * @param objects: First element of the array
+     * @param count: Number of elements, including element 0
+     * @return: False if the pool is not empty or the array is too large
+     */
+    bool adopt(T *objects, uint32_t count)
+    {
+        uint32_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        if (chunkCount.load(std::memory_order_acquire) != 0 || chunks > MAX_CHUNKS)
+        {
+            return false;
+        }
+
+        for (uint32_t chunk = 0; chunk < chunks; chunk++)
+        {
+            chunkTable[chunk] = objects + static_cast<size_t>(chunk) * CHUNK_SIZE;
+        }
+        externalChunks = chunks;
+        externalBytes = static_cast<size_t>(count) * sizeof(T);
+        chunkCount.store(chunks, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Releases every object and chunk; outstanding indices become invalid and
+     * every cursor must be reset to Cursor()
+     */
+    void clear()
+    {
+        releaseChunks();
+    }
+
+    // === ACCESS ===
+
+    /**
+     * Resolves an index (must not be NULL_NODE)
+     * @param index: Index returned by create/createRun
+     * @return: Reference to the object
+     */
+    T &get(NodeIndex index)
+    {
+        return chunkTable[index >> CHUNK_SHIFT][index & (CHUNK_SIZE - 1)];
+    }
+
+    /**
+     * Resolves an index (read-only)
+     * @param index: Index returned by create/createRun
+     * @return: Reference to the object
+     */
+    const T &get(NodeIndex index) const
+    {
+        return chunkTable[index >> CHUNK_SHIFT][index & (CHUNK_SIZE - 1)];
+    }
+
+    /**
+     * Starts loading an object into the cache without waiting for it
+     * @param index: Index returned by create/createRun
+     */
+    void prefetch(NodeIndex index) const
+    {
+        prefetchLine(&get(index));
+    }
+
+    // === METRICS ===
+
+    /**
+     * Gets the memory held by the pool (whole owned chunks, used or not, plus adopted memory)
+     * @return: Memory in bytes
+     */
+    long long getMemoryUsage() const
+    {
+        uint32_t owned = chunkCount.load(std::memory_order_acquire) - externalChunks;
+        return static_cast<long long>(owned) * chunkBytes() + static_cast<long long>(externalBytes);
+    }
+
+    /**
+     * Gets the number of chunks claimed so far
+     * @return: Chunk count
+     */
+    int getChunkCount() const
+    {
+        return static_cast<int>(chunkCount.load(std::memory_order_acquire));
+    }
+};
+
+#endif
@@ -0,0 +1,220 @@
+#include "QueryEngine.h"
+
+#include <algorithm>
+#include <chrono>
+
+// =========================================
+// CONSTRUCTOR / DESTRUCTOR
+// =========================================
+
+/**
+ * Constructor - starts the worker threads
+ * The workers sleep until run() publishes a batch
+ * @param tree: BinaryTree to serve
+ * @param trie: Trie to serve
+ * @param frozenTrie: Frozen (double-array) Trie to serve
+ * @param threadCount: Number of worker threads (0 = one per hardware thread)
+ */
+QueryEngine::QueryEngine(const BinaryTree &tree, const Trie &trie, const DoubleArrayTrie &frozenTrie, int threadCount)
+    : tree(tree), trie(trie), frozenTrie(frozenTrie),
+      jobQueries(nullptr), jobResults(nullptr), jobCount(0), jobIndex(QueryIndex::TREE), jobTimed(false), nextQuery(0),
+      generation(0), busyWorkers(0), stopping(false)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    // Size the vector first: the threads keep references into it
+    workers.resize(threadCount);
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers[i].found = 0;
+        workers[i].thread = std::thread(&QueryEngine::workerLoop, this, i);
+    }
+}
+
+/**
+ * Destructor - wakes the workers with the stop flag and joins them
+ */
+QueryEngine::~QueryEngine()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+
+    for (Worker &worker : workers)
+    {
+        worker.thread.join();
+    }
+}
+
+// =========================================
+// WORKERS
+// =========================================
+
+/**
+ * Answers one query from the index selected for the current batch
+ * @param name: Word to search for
+ * @return: Matching record, or nullptr
+ */
+const Word *QueryEngine::answer(const std::string &name) const
+{
+    switch (jobIndex)
+    {
+    case QueryIndex::TREE:
+        return tree.search(name);
+    case QueryIndex::TRIE:
+        return trie.search(name);
+    default:
+        return frozenTrie.search(name);
+    }
+}
+
+/**
+ * Main loop of a worker thread
+ * Waits for a new batch, then repeatedly claims CHUNK_SIZE queries with one
+ * atomic increment and answers them; the last worker to finish wakes run()
+ * Everything between the two waits is lock-free
+ * In a timed batch only every LATENCY_SAMPLING-th query is bracketed by clock
+ * reads, so the two reads (about as costly as a lookup) don't slow the batch
+ * @param worker: Index of the worker in workers
+ */
+void QueryEngine::workerLoop(int worker)
+{
+    Worker &self = workers[worker];
+    unsigned long long seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobReady.wait(lock, [&]()
+                          { return stopping || generation != seenGeneration; });
+            if (stopping)
+            {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        // Answer chunks until the batch is exhausted (no locks on this path)
+        self.latencies.clear();
+        self.found = 0;
+        while (true)
+        {
+            size_t first = nextQuery.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+            if (first >= jobCount)
+            {
+                break;
+            }
+            size_t last = std::min(first + CHUNK_SIZE, jobCount);
+            for (size_t i = first; i < last; i++)
+            {
+                const Word *result;
+                if (jobTimed && i % LATENCY_SAMPLING == 0)
+                {
+                    auto start = std::chrono::steady_clock::now();
+                    result = answer(jobQueries[i]);
+                    auto end = std::chrono::steady_clock::now();
+                    self.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                }
+                else
+                {
+                    result = answer(jobQueries[i]);
+                }
+
+                jobResults[i] = result;
+                self.found += (result != nullptr) ? 1 : 0;
+            }
+        }
+
+        // Report completion; the mutex also publishes the results to run()
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            busyWorkers--;
+            if (busyWorkers == 0)
+            {
+                jobDone.notify_one();
+            }
+        }
+    }
+}
+
+// =========================================
+// MAIN OPERATIONS
+// =========================================
+
+/**
+ * Answers a batch of queries on the worker threads and waits for them
+ * Publishes the batch, wakes every worker, waits for the last one and then
+ * merges the per-thread latency samples into percentiles
+ * @param queries: Words to search for
+ * @param count: Number of queries
+ * @param index: Index to answer from
+ * @param results: Receives one record pointer (or nullptr) per query
+ * @param timed: Sample per-query latencies (false = no clock reads, for throughput)
+ * @return: Hit count, wall-clock time and (if timed) latency percentiles of the batch
+ */
+QueryStats QueryEngine::run(const std::string *queries, size_t count, QueryIndex index, const Word **results,
+                            bool timed)
+{
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobQueries = queries;
+        jobResults = results;
+        jobCount = count;
+        jobIndex = index;
+        jobTimed = timed;
+        nextQuery.store(0, std::memory_order_relaxed);
+        busyWorkers = static_cast<int>(workers.size());
+        generation++;
+    }
+    jobReady.notify_all();
+
+    {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobDone.wait(lock, [this]()
+                     { return busyWorkers == 0; });
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Merge the per-thread buffers
+    QueryStats stats = {count, 0, std::chrono::duration<double>(end - start).count(), 0, 0};
+    std::vector<long long> latencies;
+    latencies.reserve(timed ? count / LATENCY_SAMPLING + 1 : 0);
+    for (const Worker &worker : workers)
+    {
+        stats.found += worker.found;
+        latencies.insert(latencies.end(), worker.latencies.begin(), worker.latencies.end());
+    }
+
+    if (!latencies.empty())
+    {
+        auto percentile = [&latencies](double fraction)
+        {
+            size_t rank = std::min(latencies.size() - 1, static_cast<size_t>(fraction * latencies.size()));
+            std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+            return latencies[rank];
+        };
+        stats.p50 = percentile(0.50);
+        stats.p99 = percentile(0.99);
+    }
+    return stats;
+}
+
+// =========================================
+// GETTERS
+// =========================================
+
+/**
+ * Gets the number of worker threads
+ * @return: Worker count
+ */
+int QueryEngine::getThreadCount() const
+{
+    return static_cast<int>(workers.size());
+}
@@ -0,0 +1,140 @@
+#ifndef QUERYENGINE_H
+#define QUERYENGINE_H
+
+#include "BinaryTree.h"
+#include "Trie.h"
+#include "DoubleArrayTrie.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * QueryIndex - Which index a QueryEngine batch is answered from
+ */
+enum class QueryIndex
+{
+    TREE,       // BinaryTree::search (case-sensitive)
+    TRIE,       // Trie::search (case-insensitive)
+    FROZEN_TRIE // DoubleArrayTrie::search (case-insensitive)
+};
+
+/**
+ * QueryStats - Outcome of one QueryEngine::run
+ */
+struct QueryStats
+{
+    size_t queries; // Queries answered
+    size_t found;   // Queries that found a record
+    double seconds; // Wall-clock time of the whole batch
+    long long p50;  // Median per-query latency (nanoseconds; 0 if latencies weren't sampled)
+    long long p99;  // 99th percentile per-query latency (nanoseconds; 0 if latencies weren't sampled)
+};
+
+/**
+ * QueryEngine - Pool of worker threads serving lookups against shared indexes
+ * The indexes must not be modified while the engine is in use; searches are
+ * const and touch no shared mutable state, so the read path takes no locks.
+ * Workers claim chunks of a batch with one atomic counter, write results into
+ * disjoint slots of the caller's array and keep their sampled latencies in
+ * per-thread buffers that are merged once the batch is done
+ */
+class QueryEngine
+{
+private:
+    /**
+     * Worker - Per-thread state, cache-line aligned so workers never share a line
+     */
+    struct alignas(64) Worker
+    {
+        std::thread thread;               // The worker thread
+        std::vector<long long> latencies; // Sampled per-query latencies of the current batch (nanoseconds)
+        size_t found;                     // Hits in the current batch
+    };
+
+    const BinaryTree &tree;            // Indexes being served (read-only)
+    const Trie &trie;
+    const DoubleArrayTrie &frozenTrie;
+
+    std::vector<Worker> workers;       // One entry per worker thread
+
+    // Current batch (published under jobMutex, then read without locks)
+    const std::string *jobQueries;     // Queries of the batch
+    const Word **jobResults;           // Result slot per query
+    size_t jobCount;                   // Number of queries
+    QueryIndex jobIndex;               // Index to answer from
+    bool jobTimed;                     // Whether to sample per-query latencies
+    std::atomic<size_t> nextQuery;     // First query not yet claimed by a worker
+
+    // Batch hand-off between the caller and the workers
+    std::mutex jobMutex;
+    std::condition_variable jobReady;  // Signals a new batch (or shutdown)
+    std::condition_variable jobDone;   // Signals that every worker finished the batch
+    unsigned long long generation;     // Incremented for every batch
+    int busyWorkers;                   // Workers still working on the batch
+    bool stopping;                     // Set by the destructor
+
+    static const size_t CHUNK_SIZE = 64;     // Queries claimed per atomic increment
+    static const size_t LATENCY_SAMPLING = 16; // Every n-th query is timed in a timed batch
+
+    /**
+     * Main loop of a worker thread: waits for a batch, answers its share, repeats
+     * @param worker: Index of the worker in workers
+     */
+    void workerLoop(int worker);
+
+    /**
+     * Answers one query from the selected index
+     * @param name: Word to search for
+     * @return: Matching record, or nullptr
+     */
+    const Word *answer(const std::string &name) const;
+
+public:
+    // === CONSTRUCTOR / DESTRUCTOR ===
+
+    /**
+     * Constructor - starts the worker threads
+     * @param tree: BinaryTree to serve
+     * @param trie: Trie to serve
+     * @param frozenTrie: Frozen (double-array) Trie to serve
+     * @param threadCount: Number of worker threads (0 = one per hardware thread)
+     */
+    QueryEngine(const BinaryTree &tree, const Trie &trie, const DoubleArrayTrie &frozenTrie, int threadCount = 0);
+
+    /**
+     * Destructor - stops and joins the worker threads
+     */
+    ~QueryEngine();
+
+    QueryEngine(const QueryEngine &) = delete;
+    QueryEngine &operator=(const QueryEngine &) = delete;
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Answers a batch of queries on the worker threads and waits for them
+     * Only one batch runs at a time; call from a single thread
+     * @param queries: Words to search for
+     * @param count: Number of queries
+     * @param index: Index to answer from
+     * @param results: Receives one record pointer (or nullptr) per query
+     * @param timed: Sample per-query latencies (false = no clock reads, for throughput)
+     * @return: Hit count, wall-clock time and (if timed) latency percentiles of the batch
+     */
+    QueryStats run(const std::string *queries, size_t count, QueryIndex index, const Word **results,
+                   bool timed = true);
+
+    // === GETTERS ===
+
+    /**
+     * Gets the number of worker threads
+     * @return: Worker count
+     */
+    int getThreadCount() const;
+};
+
+#endif
@@ -0,0 +1,288 @@
+#include "RadixTrie.h"
+
+#include <cctype>
+#include <cstring>
+
+// =========================================
+// RADIXNODE IMPLEMENTATION
+// =========================================
+
+/**
+ * RadixNode Constructor
+ * @param label: Lowercase edge label from the parent
+ */
+RadixNode::RadixNode(const std::string &label)
+    : label(label), wordId(WordStore::INVALID_ID), isEndOfWord(false) {}
+
+/**
+ * Finds the child whose label starts with a character
+ * Children are few and sorted, so a linear scan over the first bytes is enough
+ * @param first: First character of the label
+ * @return: Index in children, or -1 if there is none
+ */
+int RadixNode::findChild(char first) const
+{
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if (children[i]->label[0] == first)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// =========================================
+// RADIXTRIE IMPLEMENTATION
+// =========================================
+
+/**
+ * RadixTrie Constructor
+ * Creates an empty trie with a root node
+ * @param store: Record store holding the words (must outlive the trie)
+ */
+RadixTrie::RadixTrie(const WordStore &store) : store(&store), nodeCount(0)
+{
+    root = new RadixNode("");
+}
+
+/**
+ * RadixTrie Destructor
+ * Destroys every node starting from the root
+ */
+RadixTrie::~RadixTrie()
+{
+    destroyTrie(root);
+}
+
+/**
+ * Iteratively destroys all nodes with an explicit heap-allocated stack
+ * @param node: Root of the subtree to destroy
+ */
+void RadixTrie::destroyTrie(RadixNode *node)
+{
+    std::vector<RadixNode *> stack;
+
+    if (node != nullptr)
+    {
+        stack.push_back(node);
+    }
+
+    while (!stack.empty())
+    {
+        RadixNode *current = stack.back();
+        stack.pop_back();
+
+        for (RadixNode *child : current->children)
+        {
+            stack.push_back(child);
+        }
+        delete current;
+    }
+}
+
+// =========================================
+// INSERTION OPERATION
+// =========================================
+
+/**
+ * Inserts a word into the radix trie
+ * Walks down matching whole labels; where the word diverges inside a label,
+ * the edge is split into a shared prefix node and the old suffix
+ * Time Complexity: O(m) where m is the length of the word
+ * @param id: Record ID of the word in the WordStore
+ */
+void RadixTrie::insert(WordId id)
+{
+    // Lowercase once for case-insensitive matching (same rule as Trie)
+    std::string_view original = store->get(id).getWord();
+    std::string key(original.size(), '\0');
+    for (size_t i = 0; i < original.size(); i++)
+    {
+        key[i] = tolower(original[i]);
+    }
+
+    RadixNode *current = root;
+    size_t position = 0;
+
+    while (position < key.size())
+    {
+        int index = current->findChild(key[position]);
+
+        if (index < 0)
+        {
+            // No edge starts with this character: hang the rest of the word as one leaf
+            RadixNode *leaf = new RadixNode(key.substr(position));
+            auto insertAt = current->children.begin();
+            while (insertAt != current->children.end() &&
+                   static_cast<unsigned char>((*insertAt)->label[0]) < static_cast<unsigned char>(key[position]))
+            {
+                ++insertAt;
+            }
+            current->children.insert(insertAt, leaf);
+            nodeCount++;
+            current = leaf;
+            position = key.size();
+            break;
+        }
+
+        RadixNode *child = current->children[index];
+        const std::string &label = child->label;
+
+        // Length of the common prefix between the label and the rest of the word
+        size_t common = 0;
+        while (common < label.size() && position + common < key.size() &&
+               label[common] == key[position + common])
+        {
+            common++;
+        }
+
+        if (common < label.size())
+        {
+            // Split: prefix node takes the shared part, old child keeps the suffix
+            RadixNode *prefix = new RadixNode(label.substr(0, common));
+            child->label = label.substr(common);
+            prefix->children.push_back(child);
+            current->children[index] = prefix;
+            nodeCount++;
+            child = prefix;
+        }
+
+        current = child;
+        position += common;
+    }
+
+    // Mark the last node as end of a valid word (a later duplicate replaces the ID)
+    current->isEndOfWord = true;
+    current->wordId = id;
+}
+
+/**
+ * Indexes every record currently in the WordStore, in ID order
+ * Produces the same word -> record mapping as inserting the same IDs into Trie
+ */
+void RadixTrie::indexAll()
+{
+    for (int id = 0; id < store->size(); id++)
+    {
+        insert(static_cast<WordId>(id));
+    }
+}
+
+// =========================================
+// SEARCH OPERATION
+// =========================================
+
+/**
+ * Searches for a word in the radix trie
+ * The query is lowercased into a stack buffer (heap only for very long words),
+ * then each edge label is compared with a single memcmp
+ * Time Complexity: O(m) where m is the length of the word
+ * @param name: The word to search for
+ * @return: Pointer to the Word record if found, nullptr otherwise
+ */
+const Word *RadixTrie::search(const std::string &name) const
+{
+    char buffer[128];
+    std::string longKey;
+    char *key = buffer;
+    if (name.size() > sizeof(buffer))
+    {
+        longKey.resize(name.size());
+        key = &longKey[0];
+    }
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        key[i] = tolower(name[i]);
+    }
+
+    const RadixNode *current = root;
+    size_t position = 0;
+
+    while (position < name.size())
+    {
+        int index = current->findChild(key[position]);
+        if (index < 0)
+        {
+            return nullptr; // No edge for this character
+        }
+
+        const RadixNode *child = current->children[index];
+        size_t labelLength = child->label.size();
+        if (labelLength > name.size() - position ||
+            std::memcmp(child->label.data(), key + position, labelLength) != 0)
+        {
+            return nullptr; // Word ends inside the label or diverges from it
+        }
+
+        current = child;
+        position += labelLength;
+    }
+
+    return current->isEndOfWord ? &store->get(current->wordId) : nullptr;
+}
+
+// =========================================
+// PERFORMANCE MEASUREMENT
+// =========================================
+
+/**
+ * Searches for a word and measures the time taken
+ * @param name: The word to search for
+ * @param result: Reference parameter to store the search result
+ * @return: Time taken for the search in nanoseconds
+ */
+long long RadixTrie::searchWithTiming(const std::string &name, const Word *&result)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    result = search(name);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// =========================================
+// MEMORY USAGE CALCULATION
+// =========================================
+
+/**
+ * Calculates the memory used by the radix trie index
+ * Includes: node size, heap-allocated label storage, and child array capacity
+ * @return: Total memory in bytes
+ */
+long long RadixTrie::getMemoryUsage() const
+{
+    long long totalSize = 0;
+    std::vector<const RadixNode *> stack;
+    stack.push_back(root);
+
+    while (!stack.empty())
+    {
+        const RadixNode *current = stack.back();
+        stack.pop_back();
+
+        totalSize += sizeof(RadixNode);
+        // Short labels live inside the string object (SSO); longer ones on the heap
+        if (current->label.capacity() > std::string().capacity())
+        {
+            totalSize += current->label.capacity() + 1;
+        }
+        totalSize += current->children.capacity() * sizeof(RadixNode *);
+
+        for (const RadixNode *child : current->children)
+        {
+            stack.push_back(child);
+        }
+    }
+
+    return totalSize;
+}
+
+/**
+ * Returns the total number of nodes in the radix trie
+ * @return: Node count
+ */
+int RadixTrie::getNodeCount() const
+{
+    return nodeCount;
+}
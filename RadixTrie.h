@@ -0,0 +1,110 @@
+#ifndef RADIXTRIE_H
+#define RADIXTRIE_H
+
+#include "WordStore.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * RadixNode - Node in the path-compressed trie
+ * The edge from the parent is labeled with a whole lowercase string instead of
+ * a single character, so chains of single-child nodes collapse into one node
+ */
+class RadixNode
+{
+public:
+    std::string label;                // Lowercase edge label from the parent (empty for the root)
+    std::vector<RadixNode *> children; // Children, sorted by the first character of their label
+    WordId wordId;                    // Record ID in the WordStore (valid if isEndOfWord)
+    bool isEndOfWord;
+
+    RadixNode(const std::string &label);
+
+    /**
+     * Finds the child whose label starts with a character
+     * @param first: First character of the label
+     * @return: Index in children, or -1 if there is none
+     */
+    int findChild(char first) const;
+};
+
+/**
+ * RadixTrie - Path-compressed (Patricia) variant of Trie
+ * Same insert/search API and the same case-insensitive semantics as Trie;
+ * labels are matched with memcmp against the lowercased query
+ * Time Complexity: O(m) where m is the length of the word, with one pointer hop
+ * per branching point instead of one per character
+ */
+class RadixTrie
+{
+private:
+    const WordStore *store; // Shared record store that node IDs refer to
+    RadixNode *root;        // Root node (empty label)
+    int nodeCount;          // Total number of nodes (excluding the root, like Trie)
+
+    // === PRIVATE HELPER FUNCTIONS ===
+
+    /**
+     * Iteratively destroys all nodes below and including a node
+     * @param node: Root of the subtree to destroy
+     */
+    void destroyTrie(RadixNode *node);
+
+public:
+    // === CONSTRUCTOR & DESTRUCTOR ===
+
+    /**
+     * Constructor
+     * @param store: Record store holding the words (must outlive the trie)
+     */
+    RadixTrie(const WordStore &store);
+    ~RadixTrie();
+
+    RadixTrie(const RadixTrie &) = delete;
+    RadixTrie &operator=(const RadixTrie &) = delete;
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Inserts a word, splitting an edge label where the new word diverges
+     * @param id: Record ID of the word in the WordStore
+     */
+    void insert(WordId id);
+
+    /**
+     * Indexes every record currently in the WordStore, in ID order
+     */
+    void indexAll();
+
+    /**
+     * Searches for a word (case-insensitive, like Trie::search)
+     * @param name: Word to search for
+     * @return: Pointer to the Word record if found, nullptr otherwise
+     */
+    const Word *search(const std::string &name) const;
+
+    // === PERFORMANCE METRICS ===
+
+    /**
+     * Searches for a word and measures execution time
+     * @param name: Word to search for
+     * @param result: Reference parameter to store search result
+     * @return: Search time in nanoseconds
+     */
+    long long searchWithTiming(const std::string &name, const Word *&result);
+
+    /**
+     * Gets the memory used by the radix trie index (nodes, labels, child arrays)
+     * @return: Memory used in bytes
+     */
+    long long getMemoryUsage() const;
+
+    /**
+     * Gets the total number of nodes
+     * @return: Node count
+     */
+    int getNodeCount() const;
+};
+
+#endif
@@ -0,0 +1,334 @@
+#include "Snapshot.h"
+#include "BinaryTree.h"
+#include "Trie.h"
+#include "WordStore.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// =========================================
+// FILE FORMAT
+// =========================================
+
+/**
+ * SnapshotHeader - Fixed-size header at the start of every snapshot file
+ * Followed by sectionCount SnapshotSectionEntry records and the payload
+ */
+struct SnapshotHeader
+{
+    char magic[8];         // "DICTSNAP"
+    uint32_t version;      // SnapshotReader::VERSION at write time
+    uint32_t layoutTag;    // Byte order and node struct sizes of the writer, one byte each
+    uint64_t sourceSize;   // Size of the text file the snapshot was built from
+    uint64_t fileBytes;    // Total file size
+    uint64_t checksum;     // Checksum of everything after the header
+    uint32_t sectionCount;     // Number of section table entries
+    uint32_t sectionEntrySize; // sizeof(SnapshotSectionEntry) of the writer
+};
+
+static const char SNAPSHOT_MAGIC[8] = {'D', 'I', 'C', 'T', 'S', 'N', 'A', 'P'};
+static const size_t SNAPSHOT_ALIGNMENT = 64;
+
+/**
+ * Rounds a size up to the section alignment
+ * @param size: Size in bytes
+ * @return: Next multiple of SNAPSHOT_ALIGNMENT
+ */
+static size_t alignSection(size_t size)
+{
+    return (size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+
+static_assert(sizeof(TreeNode) < 256 && sizeof(TrieNode) < 256 &&
+                  sizeof(DoubleArrayTrie::DoubleArrayUnit) < 256,
+              "Layout tag stores each node size in one byte");
+
+/**
+ * Describes the in-memory layout a snapshot depends on
+ * Byte order, TreeNode, TrieNode and DoubleArrayUnit sizes each get their own byte,
+ * so no two different layouts share a tag
+ * A snapshot written on a machine with other struct sizes or byte order is rejected
+ * @return: Layout tag
+ */
+static uint32_t currentLayoutTag()
+{
+    const uint32_t byteOrder = 0x01020304;
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &byteOrder, 1);
+
+    return (static_cast<uint32_t>(firstByte) << 24) |
+           (static_cast<uint32_t>(sizeof(TreeNode)) << 16) |
+           (static_cast<uint32_t>(sizeof(TrieNode)) << 8) |
+           static_cast<uint32_t>(sizeof(DoubleArrayTrie::DoubleArrayUnit));
+}
+
+/**
+ * Size of one element of a section, used to validate its byte count
+ * @param id: Section identifier
+ * @return: Element size in bytes, or 0 for an unknown section
+ */
+static size_t elementSizeOf(uint32_t id)
+{
+    switch (static_cast<SnapshotSection>(id))
+    {
+    case SnapshotSection::STORE_TEXT:
+        return 1;
+    case SnapshotSection::STORE_RECORDS:
+        return 6 * sizeof(uint32_t); // Offset and length of the three fields
+    case SnapshotSection::TREE_NODES:
+        return sizeof(TreeNode);
+    case SnapshotSection::TRIE_NODES:
+        return sizeof(TrieNode);
+    case SnapshotSection::TRIE_SLOTS:
+        return sizeof(NodeIndex);
+    case SnapshotSection::FROZEN_UNITS:
+        return sizeof(DoubleArrayTrie::DoubleArrayUnit);
+    case SnapshotSection::FROZEN_VALUES:
+        return sizeof(WordId);
+    case SnapshotSection::FROZEN_FIRST_CHILD:
+    case SnapshotSection::FROZEN_NEXT_SIBLING:
+        return sizeof(uint16_t);
+    }
+    return 0;
+}
+
+/**
+ * 64-bit checksum, eight bytes per step so validating a snapshot stays cheap
+ * @param data: First byte
+ * @param bytes: Number of bytes
+ * @return: Checksum
+ */
+static uint64_t checksumOf(const char *data, size_t bytes)
+{
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+    uint64_t hash = 0xCBF29CE484222325ull ^ bytes;
+
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 29;
+    }
+    for (; i < bytes; i++)
+    {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * multiplier;
+    }
+    return hash ^ (hash >> 32);
+}
+
+// =========================================
+// WRITER
+// =========================================
+
+/**
+ * Appends a section; its payload starts on a 64-byte boundary
+ * @param id: Section identifier
+ * @param data: First byte of the array
+ * @param bytes: Array size in bytes
+ * @param count: Number of elements
+ * @param param0: Structure-defined scalar
+ * @param param1: Structure-defined scalar
+ */
+void SnapshotWriter::addSection(SnapshotSection id, const void *data, size_t bytes, size_t count,
+                                uint64_t param0, uint64_t param1)
+{
+    SnapshotSectionEntry entry;
+    entry.id = static_cast<uint32_t>(id);
+    entry.count = static_cast<uint32_t>(count);
+    entry.offset = payload.size(); // Relative for now; made absolute in writeFile
+    entry.bytes = bytes;
+    entry.param0 = param0;
+    entry.param1 = param1;
+    sections.push_back(entry);
+
+    const char *bytesIn = static_cast<const char *>(data);
+    payload.insert(payload.end(), bytesIn, bytesIn + bytes);
+    payload.resize(alignSection(payload.size()), 0);
+}
+
+/**
+ * Writes header, section table and payload to a temporary file, then renames it
+ * @param filename: Destination path
+ * @param sourceSize: Size of the text file the snapshot was built from
+ * @return: True on success
+ */
+bool SnapshotWriter::writeFile(const std::string &filename, uint64_t sourceSize) const
+{
+    size_t tableBytes = sections.size() * sizeof(SnapshotSectionEntry);
+    size_t payloadStart = alignSection(sizeof(SnapshotHeader) + tableBytes);
+
+    // Body = table + padding + payload; the checksum covers all of it
+    std::vector<char> body(payloadStart - sizeof(SnapshotHeader) + payload.size(), 0);
+    std::vector<SnapshotSectionEntry> table = sections;
+    for (SnapshotSectionEntry &entry : table)
+    {
+        entry.offset += payloadStart;
+    }
+    if (tableBytes > 0)
+    {
+        std::memcpy(body.data(), table.data(), tableBytes);
+    }
+    if (!payload.empty())
+    {
+        std::memcpy(body.data() + (payloadStart - sizeof(SnapshotHeader)), payload.data(), payload.size());
+    }
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SnapshotReader::VERSION;
+    header.layoutTag = currentLayoutTag();
+    header.sourceSize = sourceSize;
+    header.fileBytes = sizeof(SnapshotHeader) + body.size();
+    header.checksum = checksumOf(body.data(), body.size());
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+    header.sectionEntrySize = sizeof(SnapshotSectionEntry);
+
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(body.data(), static_cast<std::streamsize>(body.size()));
+        if (!file)
+        {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    if (error)
+    {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+// =========================================
+// READER
+// =========================================
+
+/**
+ * SnapshotReader Constructor
+ * Creates a reader with no snapshot open
+ */
+SnapshotReader::SnapshotReader() : base(nullptr), sourceSize(0) {}
+
+/**
+ * Maps a snapshot copy-on-write and validates it
+ * Validation reads the file once for the checksum; nothing is parsed or copied
+ * @param filename: Snapshot path
+ * @return: True if the snapshot is intact and compatible
+ */
+bool SnapshotReader::open(const std::string &filename)
+{
+    std::unique_ptr<MappedFile> mapping(new MappedFile());
+    if (!mapping->open(filename, true) || mapping->getSize() < sizeof(SnapshotHeader))
+    {
+        return false;
+    }
+
+    char *bytes = mapping->getWritableData();
+    if (bytes == nullptr)
+    {
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != VERSION || header.layoutTag != currentLayoutTag() ||
+        header.sectionEntrySize != sizeof(SnapshotSectionEntry) || header.fileBytes != mapping->getSize())
+    {
+        return false;
+    }
+
+    size_t tableBytes = static_cast<size_t>(header.sectionCount) * sizeof(SnapshotSectionEntry);
+    if (sizeof(SnapshotHeader) + tableBytes > mapping->getSize())
+    {
+        return false;
+    }
+
+    const char *body = bytes + sizeof(SnapshotHeader);
+    if (checksumOf(body, mapping->getSize() - sizeof(SnapshotHeader)) != header.checksum)
+    {
+        return false;
+    }
+
+    std::vector<SnapshotSectionEntry> table(header.sectionCount);
+    if (tableBytes > 0)
+    {
+        std::memcpy(table.data(), body, tableBytes);
+    }
+    for (const SnapshotSectionEntry &entry : table)
+    {
+        size_t elementSize = elementSizeOf(entry.id);
+        if (entry.offset % SNAPSHOT_ALIGNMENT != 0 || entry.offset > mapping->getSize() ||
+            entry.bytes > mapping->getSize() - entry.offset || elementSize == 0 ||
+            entry.bytes != static_cast<uint64_t>(entry.count) * elementSize)
+        {
+            return false;
+        }
+    }
+
+    file = std::move(mapping);
+    base = bytes;
+    sections = std::move(table);
+    sourceSize = header.sourceSize;
+    return true;
+}
+
+/**
+ * Hands the mapping to the store (the mapped address does not change)
+ * @param store: Store that takes ownership of the mapping
+ */
+void SnapshotReader::attachTo(WordStore &store)
+{
+    if (file != nullptr)
+    {
+        store.adoptFile(std::move(file));
+    }
+}
+
+/**
+ * Finds a section by identifier
+ * @param id: Section identifier
+ * @return: Entry, or nullptr if the snapshot has no such section
+ */
+const SnapshotSectionEntry *SnapshotReader::find(SnapshotSection id) const
+{
+    for (const SnapshotSectionEntry &entry : sections)
+    {
+        if (entry.id == static_cast<uint32_t>(id))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Gets a section's data in place
+ * @param entry: Entry returned by find()
+ * @return: Pointer into the copy-on-write mapping
+ */
+char *SnapshotReader::data(const SnapshotSectionEntry &entry) const
+{
+    return base + entry.offset;
+}
+
+/**
+ * Gets the size of the text file the snapshot was built from
+ * @return: Size in bytes
+ */
+uint64_t SnapshotReader::getSourceSize() const
+{
+    return sourceSize;
+}
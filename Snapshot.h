@@ -0,0 +1,134 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class WordStore;
+
+/**
+ * SnapshotSection - Identifies one array inside a snapshot file
+ * Each structure writes and reads its own sections
+ */
+enum class SnapshotSection : uint32_t
+{
+    STORE_TEXT = 1,      // Concatenated word / part-of-speech / definition text
+    STORE_RECORDS,       // Per-record offsets and lengths into STORE_TEXT
+    TREE_NODES,          // BinaryTree node arena (breadth-first, root at index 1)
+    TRIE_NODES,          // Trie node arena (breadth-first, root at index 1)
+    TRIE_SLOTS,          // Trie child slot runs
+    FROZEN_UNITS,        // DoubleArrayTrie BASE/CHECK pairs
+    FROZEN_VALUES,       // DoubleArrayTrie record IDs per cell
+    FROZEN_FIRST_CHILD,  // DoubleArrayTrie first-child codes
+    FROZEN_NEXT_SIBLING  // DoubleArrayTrie next-sibling codes
+};
+
+/**
+ * SnapshotSectionEntry - Table-of-contents entry describing one section
+ * Two free parameters let a structure store scalars (root, counts, mode)
+ */
+struct SnapshotSectionEntry
+{
+    uint32_t id;     // SnapshotSection value
+    uint32_t count;  // Number of elements
+    uint64_t offset; // Byte offset from the start of the file (64-byte aligned)
+    uint64_t bytes;  // Payload size in bytes
+    uint64_t param0; // Structure-defined scalar
+    uint64_t param1; // Structure-defined scalar
+};
+
+/**
+ * SnapshotWriter - Collects sections and writes a versioned, checksummed snapshot
+ * File layout: fixed header, section table, then the 64-byte aligned payloads.
+ * Every section is a flat array of fixed-size structs addressed by 32-bit
+ * indices, so a reader can use it in place with no pointer fix-ups
+ */
+class SnapshotWriter
+{
+private:
+    std::vector<SnapshotSectionEntry> sections; // Table of contents (offsets relative to payload)
+    std::vector<char> payload;                  // All section data, aligned
+
+public:
+    /**
+     * Appends a section (the data is copied)
+     * @param id: Section identifier
+     * @param data: First byte of the array
+     * @param bytes: Array size in bytes
+     * @param count: Number of elements
+     * @param param0: Structure-defined scalar
+     * @param param1: Structure-defined scalar
+     */
+    void addSection(SnapshotSection id, const void *data, size_t bytes, size_t count,
+                    uint64_t param0 = 0, uint64_t param1 = 0);
+
+    /**
+     * Writes the snapshot through a temporary file renamed into place,
+     * so a crash never leaves a half-written snapshot behind
+     * @param filename: Destination path
+     * @param sourceSize: Size of the text file the snapshot was built from
+     * @return: True on success
+     */
+    bool writeFile(const std::string &filename, uint64_t sourceSize) const;
+};
+
+/**
+ * SnapshotReader - Maps a snapshot and hands out its sections in place
+ * The mapping is copy-on-write; once the caller has decided to use the
+ * snapshot, attachTo() gives it to the WordStore, so structures built on it
+ * stay valid (and even mutable) for the store's lifetime
+ */
+class SnapshotReader
+{
+private:
+    std::unique_ptr<MappedFile> file;           // Mapping until attachTo() hands it over
+    char *base;                                 // First byte of the mapped file (nullptr if not open)
+    std::vector<SnapshotSectionEntry> sections; // Validated table of contents
+    uint64_t sourceSize;                        // Size of the text file the snapshot was built from
+
+public:
+    static const uint32_t VERSION = 3; // Bumped whenever the header or any section layout changes
+
+    SnapshotReader();
+
+    /**
+     * Maps a snapshot and validates it
+     * Checks magic, version, layout tag (struct sizes and byte order), section entry size, the
+     * payload checksum, and that every section is in bounds and holds whole elements
+     * @param filename: Snapshot path
+     * @return: True if the snapshot is intact and compatible
+     */
+    bool open(const std::string &filename);
+
+    /**
+     * Hands the mapping to the store; call before reading sections into structures
+     * @param store: Store that takes ownership of the mapping
+     */
+    void attachTo(WordStore &store);
+
+    /**
+     * Finds a section
+     * @param id: Section identifier
+     * @return: Entry, or nullptr if the snapshot has no such section
+     */
+    const SnapshotSectionEntry *find(SnapshotSection id) const;
+
+    /**
+     * Gets a section's data in place
+     * @param entry: Entry returned by find()
+     * @return: Pointer into the copy-on-write mapping
+     */
+    char *data(const SnapshotSectionEntry &entry) const;
+
+    /**
+     * Gets the size of the text file the snapshot was built from
+     * @return: Size in bytes
+     */
+    uint64_t getSourceSize() const;
+};
+
+#endif
@@ -1,148 +1,1561 @@
 #include "Trie.h"
 
+#include <algorithm>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 // =========================================
 // TRIENODE IMPLEMENTATION
 // =========================================
 
 /**
- * TrieNode Constructor
- * Initializes a new node with no word data and not marked as end of word
+ * TrieNode Constructor
+ * Initializes a new node with no children, no word record and not marked as end of word
+ */
+TrieNode::TrieNode()
+    : slots(NULL_NODE), wordId(WordStore::INVALID_ID), maxWeight(0), childCount(0), slotCapacity(0), isEndOfWord(false)
+{
+}
+
+/**
+ * Finds the slot holding the child for a character
+ * Small layout: one 16-byte SSE2 compare over the inline keys (linear scan elsewhere)
+ * Direct layout: the character itself is the slot (the entry may be NULL_NODE)
+ * @param key: Character of the edge to follow
+ * @return: Slot index, or -1 if there is no such edge
+ */
+int TrieNode::findSlot(char key) const
+{
+    if (slotCapacity == DIRECT_LAYOUT)
+    {
+        return static_cast<unsigned char>(key);
+    }
+
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128i needle = _mm_set1_epi8(key);
+    __m128i haystack = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys));
+    unsigned matches = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(needle, haystack)));
+    matches &= (1u << childCount) - 1; // Ignore unused key bytes
+    if (matches == 0)
+    {
+        return -1;
+    }
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, matches);
+#else
+    unsigned index = static_cast<unsigned>(__builtin_ctz(matches));
+#endif
+    return static_cast<int>(index);
+#else
+    for (int i = 0; i < childCount; i++)
+    {
+        if (keys[i] == static_cast<unsigned char>(key))
+        {
+            return i;
+        }
+    }
+    return -1;
+#endif
+}
+
+/**
+ * Returns how many slots Trie::getChildAt should visit
+ * @return: childCount for the small layout, 256 for the direct layout
+ */
+int TrieNode::getSlotCount() const
+{
+    return (slotCapacity == DIRECT_LAYOUT) ? 256 : childCount;
+}
+
+/**
+ * Returns the character of a slot; slots are visited in character order
+ * @param slot: Slot index in [0, getSlotCount())
+ * @return: The slot's character
+ */
+char TrieNode::getSlotKey(int slot) const
+{
+    return static_cast<char>((slotCapacity == DIRECT_LAYOUT) ? slot : keys[slot]);
+}
+
+// =========================================
+// TRIE IMPLEMENTATION
+// =========================================
+
+/**
+ * Trie Constructor
+ * Creates an empty Trie with a root node
+ * Nodes and slot runs come from the Trie's own arenas, which are released
+ * chunk by chunk when the Trie is destroyed (no per-node teardown)
+ * @param store: Record store holding the words (must outlive the Trie)
+ * @param hugePages: Back both arenas with huge pages where supported
+ */
+Trie::Trie(const WordStore &store, bool hugePages)
+    : store(&store), nodes(hugePages), slotArena(hugePages), nodeCount(0), epochs(nullptr)
+{
+    root = nodes.create(cursors.nodes);
+}
+
+/**
+ * Finds the child of a node for a character
+ * @param node: Parent node
+ * @param key: Character of the edge to follow
+ * @return: Child node, or NULL_NODE if there is no such edge
+ */
+NodeIndex Trie::findChild(NodeIndex node, char key) const
+{
+    const TrieNode &parent = nodes.get(node);
+    int slot = parent.findSlot(key);
+    return (slot < 0) ? NULL_NODE : slotArena.get(parent.slots + slot);
+}
+
+/**
+ * Returns the child of a node for a character, creating it if needed
+ * @param node: Parent node
+ * @param key: Character of the edge
+ * @param created: Set to true if a new child node was created
+ * @param cursors: Arena cursors of the calling thread
+ * @return: The (possibly new) child node
+ */
+NodeIndex Trie::getOrAddChild(NodeIndex node, char key, bool &created, Cursors &cursors)
+{
+    created = false;
+    NodeIndex existing = findChild(node, key);
+    if (existing != NULL_NODE)
+    {
+        return existing;
+    }
+
+    created = true;
+    NodeIndex child = nodes.create(cursors.nodes);
+    addChild(node, key, child, cursors);
+    return child;
+}
+
+/**
+ * Adds an edge to a node that doesn't have one for this character yet
+ * Small layout keeps keys sorted and doubles the slot run as it fills;
+ * the 17th child converts the node to the 256-entry direct layout
+ * Outgrown runs are not reused; they are released with the arena
+ * @param node: Parent node
+ * @param key: Character of the edge
+ * @param child: Node the edge leads to
+ * @param cursors: Arena cursors of the calling thread
+ */
+void Trie::addChild(NodeIndex node, char key, NodeIndex child, Cursors &cursors)
+{
+    TrieNode &parent = nodes.get(node);
+    unsigned char code = static_cast<unsigned char>(key);
+
+    if (parent.slotCapacity == TrieNode::DIRECT_LAYOUT)
+    {
+        slotArena.get(parent.slots + code) = child;
+        parent.childCount++;
+        return;
+    }
+
+    if (parent.childCount == TrieNode::SMALL_LIMIT)
+    {
+        // Convert to the direct layout (a fresh run is zeroed, i.e. all NULL_NODE)
+        NodeIndex direct = slotArena.createRun(cursors.slots, 256);
+        NodeIndex *directSlots = &slotArena.get(direct);
+        const NodeIndex *oldSlots = &slotArena.get(parent.slots);
+        for (int i = 0; i < parent.childCount; i++)
+        {
+            directSlots[parent.keys[i]] = oldSlots[i];
+        }
+        directSlots[code] = child;
+        parent.slots = direct;
+        parent.slotCapacity = TrieNode::DIRECT_LAYOUT;
+        parent.childCount++;
+        return;
+    }
+
+    if (parent.childCount == parent.slotCapacity)
+    {
+        // Grow the slot run: 1, 2, 4, 8, 16
+        int newCapacity = (parent.slotCapacity == 0) ? 1 : parent.slotCapacity * 2;
+        NodeIndex grown = slotArena.createRun(cursors.slots, static_cast<uint32_t>(newCapacity));
+        if (parent.childCount > 0)
+        {
+            const NodeIndex *oldSlots = &slotArena.get(parent.slots);
+            std::copy(oldSlots, oldSlots + parent.childCount, &slotArena.get(grown));
+        }
+        parent.slots = grown;
+        parent.slotCapacity = static_cast<uint8_t>(newCapacity);
+    }
+
+    // Insert keeping keys sorted so iteration is in character order
+    NodeIndex *slots = &slotArena.get(parent.slots);
+    int position = parent.childCount;
+    while (position > 0 && parent.keys[position - 1] > code)
+    {
+        parent.keys[position] = parent.keys[position - 1];
+        slots[position] = slots[position - 1];
+        position--;
+    }
+    parent.keys[position] = code;
+    slots[position] = child;
+    parent.childCount++;
+}
+
+// =========================================
+// INSERTION OPERATION
+// =========================================
+
+/**
+ * Inserts a word into the Trie structure
+ * Converts each character to lowercase for case-insensitive searching
+ * Time Complexity: O(m) where m is the length of the word
+ * @param id: Record ID of the word in the WordStore
+ */
+void Trie::insert(WordId id)
+{
+    if (epochs != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        insertConcurrent(id);
+        return;
+    }
+
+    topCacheNodes.clear(); // Cached top lists may miss the new word (see updateMaxWeights)
+    topCacheIds.clear();
+    nodeCount += insertBelow(root, store->get(id).getWord(), 0, id, cursors);
+}
+
+/**
+ * Inserts the suffix name[depth..] of a word below a given node
+ * Only touches nodes inside that node's subtree, which is what lets
+ * insertAll() build disjoint subtrees on separate threads
+ * @param start: Node that the first `depth` characters already lead to
+ * @param name: Full word text
+ * @param depth: Number of leading characters already consumed
+ * @param id: Record ID of the word in the WordStore
+ * @param cursors: Arena cursors of the calling thread
+ * @return: Number of nodes created
+ */
+int Trie::insertBelow(NodeIndex start, std::string_view name, size_t depth, WordId id, Cursors &cursors)
+{
+    NodeIndex current = start;
+    int created = 0;
+    uint32_t weight = store->getWeight(id);
+    nodes.get(start).maxWeight = std::max(nodes.get(start).maxWeight, weight);
+
+    // Traverse through each remaining character of the word
+    for (size_t i = depth; i < name.size(); i++)
+    {
+        // Convert to lowercase for case-insensitive search capability
+        char lowerC = tolower(name[i]);
+
+        // Move to the child node, creating it if it doesn't exist
+        bool isNew = false;
+        current = getOrAddChild(current, lowerC, isNew, cursors);
+        if (isNew)
+        {
+            created++; // Count new node
+        }
+
+        // Keep the subtree maximum on the path exact for top-k pruning
+        TrieNode &next = nodes.get(current);
+        next.maxWeight = std::max(next.maxWeight, weight);
+    }
+
+    // Mark the last node as end of a valid word
+    TrieNode &last = nodes.get(current);
+    bool lighter = last.isEndOfWord && store->getWeight(last.wordId) > weight;
+    last.isEndOfWord = true;
+
+    // Reference the shared record (a later duplicate simply replaces the ID)
+    last.wordId = id;
+
+    // A lighter duplicate may have held the only maximum on the path: the raised
+    // bounds would then overstate it, so recompute them bottom-up from the children
+    if (lighter)
+    {
+        std::vector<NodeIndex> path(1, start);
+        for (size_t i = depth; i < name.size(); i++)
+        {
+            path.push_back(findChild(path.back(), tolower(name[i])));
+        }
+        for (size_t i = path.size(); i-- > 0;)
+        {
+            nodes.get(path[i]).maxWeight = subtreeMaxOf(path[i]);
+        }
+    }
+
+    return created;
+}
+
+/**
+ * Computes a node's subtree maximum from its own word and its children's maxima
+ * @param node: Node whose children's maxima are up to date
+ * @return: Highest weight of any word in the node's subtree
+ */
+uint32_t Trie::subtreeMaxOf(NodeIndex node) const
+{
+    const TrieNode &current = nodes.get(node);
+    uint32_t best = current.isEndOfWord ? store->getWeight(current.wordId) : 0;
+    char key;
+    for (int slot = 0; slot < current.getSlotCount(); slot++)
+    {
+        NodeIndex child = getChildAt(node, slot, key);
+        if (child != NULL_NODE)
+        {
+            best = std::max(best, nodes.get(child).maxWeight);
+        }
+    }
+    return best;
+}
+
+/**
+ * Inserts many words, building independent subtrees in parallel
+ * Words are partitioned by their first (lowercased) character; each worker owns a
+ * set of first characters and inserts its words in the original order, so the
+ * result (including which duplicate wins) is identical to inserting serially
+ * The root's children are created up front, so workers never modify a shared node;
+ * each worker allocates through its own arena cursors
+ * @param ids: Record IDs to insert, in insertion order
+ * @param threadCount: Number of worker threads (1 = plain serial insertion)
+ */
+void Trie::insertAll(const std::vector<WordId> &ids, int threadCount)
+{
+    if (threadCount <= 1 || epochs != nullptr)
+    {
+        for (WordId id : ids)
+        {
+            insert(id);
+        }
+        return;
+    }
+
+    topCacheNodes.clear();
+    topCacheIds.clear();
+
+    // Group IDs by first character, preserving order within each group
+    // (workers never write the root, so its subtree maximum is raised here)
+    std::vector<std::vector<WordId>> buckets(256);
+    for (WordId id : ids)
+    {
+        TrieNode &rootNode = nodes.get(root);
+        rootNode.maxWeight = std::max(rootNode.maxWeight, store->getWeight(id));
+
+        std::string_view name = store->get(id).getWord();
+        if (name.empty())
+        {
+            insert(id); // Ends at the root itself
+            continue;
+        }
+        buckets[static_cast<unsigned char>(tolower(name[0]))].push_back(id);
+    }
+
+    // Assign buckets to workers, largest first, always to the least loaded worker
+    std::vector<int> order;
+    for (int c = 0; c < 256; c++)
+    {
+        if (!buckets[c].empty())
+        {
+            order.push_back(c);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&buckets](int a, int b)
+              { return buckets[a].size() > buckets[b].size(); });
+
+    std::vector<std::vector<int>> assignment(threadCount);
+    std::vector<size_t> load(threadCount, 0);
+    for (int c : order)
+    {
+        int worker = static_cast<int>(std::min_element(load.begin(), load.end()) - load.begin());
+        assignment[worker].push_back(c);
+        load[worker] += buckets[c].size();
+
+        // Create the subtree root now so workers only ever write below it
+        bool isNew = false;
+        getOrAddChild(root, static_cast<char>(c), isNew, cursors);
+        if (isNew)
+        {
+            nodeCount++;
+        }
+    }
+
+    // Build each worker's subtrees; node counts are summed after joining
+    std::vector<int> created(threadCount, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers.emplace_back([this, t, &assignment, &buckets, &created]()
+                             {
+            Cursors workerCursors;
+            for (int c : assignment[t])
+            {
+                NodeIndex subtree = findChild(root, static_cast<char>(c));
+                for (WordId id : buckets[c])
+                {
+                    created[t] += insertBelow(subtree, store->get(id).getWord(), 1, id, workerCursors);
+                }
+            } });
+    }
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers[t].join();
+        nodeCount += created[t];
+    }
+
+    // The root was raised by every weight, including duplicates replaced since
+    nodes.get(root).maxWeight = subtreeMaxOf(root);
+}
+
+// =========================================
+// CONCURRENT UPDATES
+// =========================================
+
+/**
+ * Switches the Trie to concurrent mode (see insertConcurrent)
+ * The top-k cache is dropped: cached node indices could be recycled for other
+ * nodes, and rebuilding it (updateMaxWeights) rewrites nodes in place
+ * @param epochs: Epoch manager shared with the readers
+ */
+void Trie::enableConcurrentUpdates(EpochManager &epochs)
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+    topCacheNodes.clear();
+    topCacheIds.clear();
+    this->epochs = &epochs;
+}
+
+/**
+ * Returns the number of entries in a node's slot run
+ * @param node: Node to inspect
+ * @return: 256 for the direct layout, otherwise the run's capacity (0 = no run)
+ */
+uint32_t Trie::runLengthOf(const TrieNode &node) const
+{
+    return (node.slotCapacity == TrieNode::DIRECT_LAYOUT) ? 256 : node.slotCapacity;
+}
+
+/**
+ * Makes a private copy of a node (and its slot run) whose edge for a character
+ * leads to a given child; the edge is added if the node doesn't have it
+ * If adding the edge outgrows the copied run, that run was never visible and is
+ * recycled at once
+ * @param node: Node to copy
+ * @param key: Character of the edge
+ * @param child: Node the edge should lead to
+ * @return: The copy
+ */
+NodeIndex Trie::copyWithChild(NodeIndex node, char key, NodeIndex child)
+{
+    NodeIndex copy = nodes.create(cursors.nodes, nodes.get(node));
+    TrieNode &copied = nodes.get(copy);
+    uint32_t runLength = runLengthOf(copied);
+    if (runLength > 0)
+    {
+        NodeIndex run = slotArena.createRun(cursors.slots, runLength);
+        const NodeIndex *oldSlots = &slotArena.get(copied.slots);
+        std::copy(oldSlots, oldSlots + runLength, &slotArena.get(run));
+        copied.slots = run;
+    }
+
+    int slot = copied.findSlot(key);
+    if (slot >= 0 && slotArena.get(copied.slots + slot) != NULL_NODE)
+    {
+        slotArena.get(copied.slots + slot) = child;
+        return copy;
+    }
+
+    NodeIndex copiedRun = copied.slots;
+    addChild(copy, key, child, cursors);
+    if (runLength > 0 && nodes.get(copy).slots != copiedRun)
+    {
+        slotArena.recycle(cursors.slots, copiedRun, runLength);
+    }
+    return copy;
+}
+
+/**
+ * Inserts a word by path copying, so readers never see a node change
+ * 1. Walk down from the root as far as the word's path exists
+ * 2. Build the new version bottom-up: the word's node (a copy of the existing
+ *    one, sharing its unchanged slot run, or a fresh chain of nodes for the
+ *    missing suffix), then a copy of every node above it with its edge
+ *    redirected to the copy below and its subtree maximum raised
+ * 3. Publish the new root with one atomic store: a reader sees either the old
+ *    Trie or the new one, never a half-updated node
+ * 4. Retire the replaced nodes and slot runs; they are recycled once every
+ *    reader has moved on
+ * A duplicate word points its copy at the new record (the old record stays in
+ * the append-only WordStore); if the new record is lighter, the copied maxima
+ * are recomputed from their children instead of raised. The caller holds writerMutex
+ * @param id: Record ID of the word in the WordStore
+ */
+void Trie::insertConcurrent(WordId id)
+{
+    reclaimRetired();
+
+    std::string_view name = store->get(id).getWord();
+    uint32_t weight = store->getWeight(id);
+
+    // copyPath[d] = existing node reached after d characters
+    copyPath.assign(1, root);
+    while (copyPath.size() <= name.size())
+    {
+        NodeIndex child = findChild(copyPath.back(), tolower(name[copyPath.size() - 1]));
+        if (child == NULL_NODE)
+        {
+            break;
+        }
+        copyPath.push_back(child);
+    }
+    size_t existing = copyPath.size() - 1; // Depth of the deepest existing node
+
+    // New version of the word's node: a copy sharing its unchanged slot run, or a fresh leaf
+    NodeIndex below = (existing == name.size()) ? nodes.create(cursors.nodes, nodes.get(copyPath[existing]))
+                                                : nodes.create(cursors.nodes);
+    TrieNode &last = nodes.get(below);
+    bool lighter = last.isEndOfWord && store->getWeight(last.wordId) > weight; // Replacing a heavier duplicate
+    last.isEndOfWord = true;
+    last.wordId = id;
+    last.maxWeight = lighter ? subtreeMaxOf(below) : std::max(last.maxWeight, weight);
+
+    // Fresh chain for the missing part of the word (depths existing+1 .. size-1)
+    size_t start = name.size(); // Depth of the node `below` stands for
+    if (existing < name.size())
+    {
+        nodeCount++;
+        for (; start > existing + 1; start--)
+        {
+            NodeIndex parent = nodes.create(cursors.nodes);
+            nodeCount++;
+            addChild(parent, tolower(name[start - 1]), below, cursors);
+            nodes.get(parent).maxWeight = weight;
+            below = parent;
+        }
+    }
+
+    // Copy the existing nodes above, bottom-up
+    for (size_t depth = start; depth-- > 0;)
+    {
+        below = copyWithChild(copyPath[depth], tolower(name[depth]), below);
+        TrieNode &copy = nodes.get(below);
+        copy.maxWeight = lighter ? subtreeMaxOf(below) : std::max(copy.maxWeight, weight);
+    }
+
+    // Publish, then retire what was replaced under the epoch readers may still be in
+    root = below;
+    uint64_t epoch = epochs->retireEpoch();
+    for (size_t depth = 0; depth < start; depth++)
+    {
+        const TrieNode &old = nodes.get(copyPath[depth]);
+        retired.push_back(Retired{epoch, copyPath[depth], old.slots, runLengthOf(old)});
+    }
+    if (existing == name.size())
+    {
+        retired.push_back(Retired{epoch, copyPath[existing], NULL_NODE, 0});
+    }
+}
+
+/**
+ * Recycles retired nodes and slot runs that no reader can reach any more
+ * Retired entries are queued in epoch order, so the scan stops at the first
+ * one that may still be visible
+ */
+void Trie::reclaimRetired()
+{
+    uint64_t safeEpoch = epochs->getSafeEpoch();
+    while (!retired.empty() && retired.front().epoch < safeEpoch)
+    {
+        const Retired &entry = retired.front();
+        nodes.recycle(cursors.nodes, entry.node, 1);
+        if (entry.runLength > 0)
+        {
+            slotArena.recycle(cursors.slots, entry.slots, entry.runLength);
+        }
+        retired.pop_front();
+    }
+}
+
+// =========================================
+// SEARCH OPERATION
+// =========================================
+
+/**
+ * Searches for a word in the Trie
+ * Case-insensitive search by converting to lowercase
+ * Time Complexity: O(m) where m is the length of the word
+ * @param name: The word to search for
+ * @return: Pointer to the Word record if found, nullptr otherwise
+ */
+const Word *Trie::search(const std::string &name) const
+{
+    NodeIndex current = root;
+
+    // Traverse through each character of the search word
+    for (char c : name)
+    {
+        // Convert to lowercase to match insertion format
+        char lowerC = tolower(c);
+
+        // Move to the next node in the path (one lookup per character)
+        current = findChild(current, lowerC);
+
+        // If the character path doesn't exist, word is not in the Trie
+        if (current == NULL_NODE)
+        {
+            return nullptr; // Word not found
+        }
+    }
+
+    // Return the word only if we're at a valid end-of-word node
+    const TrieNode &last = nodes.get(current);
+    return last.isEndOfWord ? &store->get(last.wordId) : nullptr;
+}
+
+/**
+ * TrieBatchLane - One in-flight lookup of searchBatch()
+ * Each character is two dependent loads (node, then its slot entry)
+ */
+struct TrieBatchLane
+{
+    size_t key;          // Index of the name being looked up
+    size_t depth;        // Characters consumed so far
+    NodeIndex node;      // Current node
+    NodeIndex slotEntry; // Slot-arena index of the child to follow (valid in stage 1)
+    int stage;           // 0 = node prefetched, 1 = slot entry prefetched
+};
+
+/**
+ * Searches for many words at once, overlapping their cache misses (AMAC)
+ * Up to BATCH_WIDTH lookups are in flight; each pass advances every lane by one
+ * load and prefetches the next, and a finished lane takes the next name at once
+ * Same results as calling search() on each name
+ * @param names: Words to search for (case-insensitive)
+ * @param count: Number of words
+ * @param results: Receives one record pointer (or nullptr) per word
+ */
+void Trie::searchBatch(const std::string_view *names, size_t count, const Word **results) const
+{
+    const size_t BATCH_WIDTH = 16;
+    TrieBatchLane lanes[BATCH_WIDTH];
+    size_t width = std::min(count, BATCH_WIDTH);
+    size_t nextKey = 0;
+    size_t active = 0;
+
+    // Points a lane at the next name; false if none is left
+    auto start = [&](TrieBatchLane &lane) -> bool
+    {
+        if (nextKey == count)
+        {
+            return false;
+        }
+        lane = TrieBatchLane{nextKey++, 0, root, NULL_NODE, 0};
+        nodes.prefetch(root);
+        return true;
+    };
+
+    bool running[BATCH_WIDTH] = {};
+    for (size_t i = 0; i < width; i++)
+    {
+        running[i] = start(lanes[i]);
+        active += running[i] ? 1 : 0;
+    }
+
+    while (active > 0)
+    {
+        for (size_t i = 0; i < width; i++)
+        {
+            if (!running[i])
+            {
+                continue;
+            }
+
+            TrieBatchLane &lane = lanes[i];
+            std::string_view name = names[lane.key];
+            const Word *result = nullptr;
+            bool finished = false;
+
+            if (lane.stage == 0)
+            {
+                const TrieNode &current = nodes.get(lane.node);
+                if (lane.depth == name.size())
+                {
+                    result = current.isEndOfWord ? &store->get(current.wordId) : nullptr;
+                    finished = true;
+                }
+                else
+                {
+                    int slot = current.findSlot(tolower(name[lane.depth]));
+                    if (slot < 0)
+                    {
+                        finished = true;
+                    }
+                    else
+                    {
+                        lane.slotEntry = current.slots + slot;
+                        slotArena.prefetch(lane.slotEntry);
+                        lane.stage = 1;
+                    }
+                }
+            }
+            else
+            {
+                NodeIndex child = slotArena.get(lane.slotEntry);
+                if (child == NULL_NODE)
+                {
+                    finished = true; // Empty entry of a direct layout
+                }
+                else
+                {
+                    lane.node = child;
+                    lane.depth++;
+                    lane.stage = 0;
+                    nodes.prefetch(child);
+                }
+            }
+
+            if (finished)
+            {
+                results[lane.key] = result;
+                running[i] = start(lane);
+                active -= running[i] ? 0 : 1;
+            }
+        }
+    }
+}
+
+// =========================================
+// PREFIX ENUMERATION
+// =========================================
+
+/**
+ * Streams every word starting with a prefix in lexicographic order
+ * Walks the prefix once, then enumerates the subtree below it; no strings are
+ * built along the way because each end-of-word node already names its record
+ * Cost is O(|prefix| + nodes under the prefix), and every node under the prefix
+ * lies on the path to at least one result
+ * @param prefix: Prefix to match (case-insensitive)
+ * @param limit: Maximum number of results (negative = unlimited)
+ * @param callback: Called once per matching record
+ * @return: Number of results delivered
+ */
+int Trie::forEachWithPrefix(const std::string &prefix, int limit,
+                            const std::function<void(const Word &)> &callback) const
+{
+    NodeIndex current = root;
+    for (char c : prefix)
+    {
+        current = findChild(current, tolower(c));
+        if (current == NULL_NODE)
+        {
+            return 0;
+        }
+    }
+    return getAllWordsHelper(current, limit, callback);
+}
+
+/**
+ * Pre-order walk of a subtree in key order (a word comes before its extensions)
+ * Uses an explicit stack, so long words can't exhaust the call stack
+ * @param start: Root of the subtree
+ * @param limit: Maximum number of results (negative = unlimited)
+ * @param callback: Called once per end-of-word node
+ * @return: Number of results delivered
+ */
+int Trie::getAllWordsHelper(NodeIndex start, int limit, const std::function<void(const Word &)> &callback) const
+{
+    if (limit == 0)
+    {
+        return 0;
+    }
+
+    int delivered = 0;
+    std::vector<NodeIndex> stack(1, start);
+
+    while (!stack.empty())
+    {
+        NodeIndex node = stack.back();
+        stack.pop_back();
+
+        const TrieNode &current = nodes.get(node);
+        if (current.isEndOfWord)
+        {
+            callback(store->get(current.wordId));
+            delivered++;
+            if (delivered == limit)
+            {
+                break;
+            }
+        }
+
+        // Push children in reverse so the smallest key is visited first
+        char key;
+        for (int slot = current.getSlotCount() - 1; slot >= 0; slot--)
+        {
+            NodeIndex child = getChildAt(node, slot, key);
+            if (child != NULL_NODE)
+            {
+                stack.push_back(child);
+            }
+        }
+    }
+    return delivered;
+}
+
+// =========================================
+// TOP-K AUTOCOMPLETE
+// =========================================
+
+/**
+ * TrieCandidate - Frontier entry of the top-k search: either a subtree, ranked by
+ * its maximum weight, or a finished word, ranked by its own weight
+ */
+struct TrieCandidate
+{
+    uint32_t weight; // Subtree maximum, or the word's weight
+    uint32_t ref;    // NodeIndex of the subtree, or WordId of the word
+    bool isWord;
+};
+
+/**
+ * Frontier order for TrieCandidate: heavier first; on equal weight a finished
+ * word comes before a subtree (the subtree can at best tie it)
+ * @param a: First candidate
+ * @param b: Second candidate
+ * @return: True if a ranks below b
+ */
+static bool ranksBelow(const TrieCandidate &a, const TrieCandidate &b)
+{
+    if (a.weight != b.weight)
+    {
+        return a.weight < b.weight;
+    }
+    if (a.isWord != b.isWord)
+    {
+        return !a.isWord;
+    }
+    return a.ref > b.ref;
+}
+
+/**
+ * Streams the k heaviest words starting with a prefix, heaviest first
+ * Best-first search over subtree maxima. Every frontier entry is a disjoint
+ * subtree (or word) that holds a word exactly as heavy as its rank, so once the
+ * frontier has as many entries as results still owed, anything lighter than its
+ * lightest entry can never be delivered: the frontier is capped at that size and
+ * light branches are dropped without being opened. With k <= 16 it stays a tiny
+ * sorted array, far cheaper than a heap over every visited sibling
+ * Requires up-to-date maxima (see updateMaxWeights())
+ * @param prefix: Prefix to match (case-insensitive)
+ * @param k: Maximum number of results (negative = every match, by weight)
+ * @param callback: Called with each record and its weight
+ * @return: Number of results delivered
  */
-TrieNode::TrieNode() : word(nullptr), isEndOfWord(false)
+int Trie::forEachTopCompletion(const std::string &prefix, int k,
+                               const std::function<void(const Word &, uint32_t)> &callback) const
 {
-    // No need to initialize children map - unordered_map handles it automatically
+    NodeIndex start = root;
+    for (char c : prefix)
+    {
+        start = findChild(start, tolower(c));
+        if (start == NULL_NODE)
+        {
+            return 0;
+        }
+    }
+    return topCompletionsBelow(start, k, callback);
 }
 
 /**
- * TrieNode Destructor
- * Cleans up the Word object if this node stores one
- * The unordered_map automatically cleans up its entries
+ * Best-first top-k search below one node (see forEachTopCompletion())
+ * A high-fanout node with a cached top list is not opened while at most
+ * TOP_CACHE_SIZE results are owed: the results that can come from its subtree
+ * are among its cached heaviest words, so those are offered instead
+ * @param start: Root of the subtree
+ * @param k: Maximum number of results (negative = every match, by weight)
+ * @param callback: Called with each record and its weight
+ * @return: Number of results delivered
  */
-TrieNode::~TrieNode()
+int Trie::topCompletionsBelow(NodeIndex start, int k,
+                              const std::function<void(const Word &, uint32_t)> &callback) const
 {
-    if (word != nullptr)
+    // Unbounded: nothing can be pruned, so sort every match by weight
+    if (k < 0)
     {
-        delete word;
+        std::vector<TrieCandidate> all;
+        getAllWordsHelper(start, -1, [this, &all](const Word &word)
+                          {
+            WordId id = store->idOf(word);
+            all.push_back(TrieCandidate{store->getWeight(id), id, true}); });
+        std::stable_sort(all.begin(), all.end(), [](const TrieCandidate &a, const TrieCandidate &b)
+                         { return a.weight > b.weight; });
+        for (const TrieCandidate &candidate : all)
+        {
+            callback(store->get(candidate.ref), candidate.weight);
+        }
+        return static_cast<int>(all.size());
     }
-    // Children map will be automatically cleaned up by unordered_map destructor
-}
 
-// =========================================
-// TRIE IMPLEMENTATION
-// =========================================
+    int delivered = 0;
+    std::vector<TrieCandidate> frontier; // Sorted by ranksBelow, best at the back
+    frontier.reserve(static_cast<size_t>(k) + 1);
+
+    auto offer = [&frontier, &delivered, k](const TrieCandidate &candidate)
+    {
+        size_t owed = static_cast<size_t>(k - delivered);
+        if (frontier.size() == owed)
+        {
+            if (!ranksBelow(frontier.front(), candidate))
+            {
+                return; // Can't beat any of the entries already owed
+            }
+            frontier.erase(frontier.begin());
+        }
+        frontier.insert(std::upper_bound(frontier.begin(), frontier.end(), candidate, ranksBelow), candidate);
+    };
+
+    if (k > 0)
+    {
+        offer(TrieCandidate{nodes.get(start).maxWeight, start, false});
+    }
+
+    while (!frontier.empty())
+    {
+        TrieCandidate best = frontier.back();
+        frontier.pop_back();
+
+        if (best.isWord)
+        {
+            callback(store->get(best.ref), best.weight);
+            delivered++;
+            continue;
+        }
+
+        const TrieNode &current = nodes.get(best.ref);
+        if (current.slotCapacity == TrieNode::DIRECT_LAYOUT && k - delivered <= TOP_CACHE_SIZE)
+        {
+            const WordId *cached = findTopCache(best.ref);
+            if (cached != nullptr)
+            {
+                for (int i = 0; i < TOP_CACHE_SIZE && cached[i] != WordStore::INVALID_ID; i++)
+                {
+                    offer(TrieCandidate{store->getWeight(cached[i]), cached[i], true});
+                }
+                continue;
+            }
+        }
+
+        if (current.isEndOfWord)
+        {
+            offer(TrieCandidate{store->getWeight(current.wordId), current.wordId, true});
+        }
+
+        // Read the slot run directly (a run never straddles chunks)
+        int slotCount = current.getSlotCount();
+        const NodeIndex *run = (slotCount > 0) ? &slotArena.get(current.slots) : nullptr;
+        for (int slot = 0; slot < slotCount; slot++)
+        {
+            if (run[slot] != NULL_NODE)
+            {
+                offer(TrieCandidate{nodes.get(run[slot]).maxWeight, run[slot], false});
+            }
+        }
+    }
+    return delivered;
+}
 
 /**
- * Trie Constructor
- * Creates an empty Trie with a root node
+ * Finds the cached top list of a node
+ * @param node: Node to look up
+ * @return: TOP_CACHE_SIZE record IDs (heaviest first, INVALID_ID padded), or nullptr
  */
-Trie::Trie() : nodeCount(0)
+const WordId *Trie::findTopCache(NodeIndex node) const
 {
-    root = new TrieNode();
+    auto found = std::lower_bound(topCacheNodes.begin(), topCacheNodes.end(), node);
+    if (found == topCacheNodes.end() || *found != node)
+    {
+        return nullptr;
+    }
+    return topCacheIds.data() + (found - topCacheNodes.begin()) * TOP_CACHE_SIZE;
 }
 
 /**
- * Trie Destructor
- * Destroys the entire Trie tree starting from root
+ * Recomputes every node's subtree maximum from the WordStore weights
+ * Nodes are listed breadth-first, then folded into their parents in reverse,
+ * so each node is visited twice and no recursion is needed
+ * Then caches the TOP_CACHE_SIZE heaviest words below every direct-layout node:
+ * those high-fanout nodes are where a best-first search would otherwise read
+ * dozens of children per step (a few hundred nodes, 64 bytes each)
+ * Time Complexity: O(number of nodes) plus one top-k search per cached node
  */
-Trie::~Trie()
+void Trie::updateMaxWeights()
 {
-    destroyTrie(root);
+    std::vector<NodeIndex> order(1, root);
+    order.reserve(static_cast<size_t>(nodeCount) + 1);
+
+    char key;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const TrieNode &current = nodes.get(order[i]);
+        for (int slot = 0; slot < current.getSlotCount(); slot++)
+        {
+            NodeIndex child = getChildAt(order[i], slot, key);
+            if (child != NULL_NODE)
+            {
+                order.push_back(child);
+            }
+        }
+    }
+
+    for (size_t i = order.size(); i-- > 0;)
+    {
+        TrieNode &current = nodes.get(order[i]);
+        uint32_t best = current.isEndOfWord ? store->getWeight(current.wordId) : 0;
+        for (int slot = 0; slot < current.getSlotCount(); slot++)
+        {
+            NodeIndex child = getChildAt(order[i], slot, key);
+            if (child != NULL_NODE)
+            {
+                best = std::max(best, nodes.get(child).maxWeight);
+            }
+        }
+        current.maxWeight = best;
+    }
+
+    topCacheNodes.clear();
+    topCacheIds.clear();
+    std::vector<NodeIndex> cacheNodes;
+    for (NodeIndex node : order)
+    {
+        if (nodes.get(node).slotCapacity == TrieNode::DIRECT_LAYOUT)
+        {
+            cacheNodes.push_back(node);
+        }
+    }
+    std::sort(cacheNodes.begin(), cacheNodes.end());
+
+    // Computed while the cache is still empty, then installed
+    std::vector<WordId> cacheIds;
+    cacheIds.reserve(cacheNodes.size() * TOP_CACHE_SIZE);
+    for (NodeIndex node : cacheNodes)
+    {
+        size_t first = cacheIds.size();
+        topCompletionsBelow(node, TOP_CACHE_SIZE, [this, &cacheIds](const Word &word, uint32_t)
+                            { cacheIds.push_back(store->idOf(word)); });
+        cacheIds.resize(first + TOP_CACHE_SIZE, WordStore::INVALID_ID);
+    }
+    topCacheNodes = std::move(cacheNodes);
+    topCacheIds = std::move(cacheIds);
 }
 
+// =========================================
+// FUZZY SEARCH
+// =========================================
+
+/**
+ * TrieFuzzyStep - Node waiting on the fuzzy search stack
+ */
+struct TrieFuzzyStep
+{
+    NodeIndex node;
+    int depth; // Depth of node (1 = child of the root)
+    char key;  // Character on the edge into node
+};
+
 /**
- * Recursively destroys all nodes in the Trie
- * Post-order traversal: destroys children first, then parent
- * @param node: Current node to destroy
+ * Finds the words within a Levenshtein distance of a query, closest first
+ * Walks the Trie depth-first carrying one DP row per depth: row d holds the
+ * distance between the d-character path and every prefix of the query, so a
+ * child's row is computed from its parent's in O(|word|). A branch is dropped
+ * as soon as every entry of its row exceeds maxEdits, since extending the path
+ * can't lower the distance; only nodes within the bound of some query prefix
+ * are visited, not the whole dictionary
+ * Only a diagonal band of 2 * maxEdits + 1 cells per row is computed (Ukkonen):
+ * a cell further from the diagonal already exceeds the bound
+ * Rows live in one flat buffer indexed by depth: a node's parent row is never
+ * overwritten before the node is expanded, because the stack finishes a whole
+ * subtree before moving to the next sibling
+ * @param word: Query word (case-insensitive)
+ * @param maxEdits: Maximum insertions + deletions + substitutions
+ * @param limit: Maximum number of results (negative = unlimited)
+ * @param callback: Called with each record and its distance
+ * @return: Number of results delivered
  */
-void Trie::destroyTrie(TrieNode *node)
+int Trie::fuzzySearch(const std::string &word, int maxEdits, int limit,
+                      const std::function<void(const Word &, int)> &callback) const
 {
-    if (node == nullptr)
+    if (maxEdits < 0 || limit == 0)
     {
-        return;
+        return 0;
+    }
+
+    std::string query(word);
+    for (char &c : query)
+    {
+        c = tolower(c);
+    }
+    const size_t width = query.size() + 1;
+    const int cap = maxEdits + 1; // Every distance beyond the bound is stored as cap
+
+    // Row 0: distance from the empty path to each query prefix
+    std::vector<int> rows(width * 8, cap);
+    for (size_t j = 0; j < width; j++)
+    {
+        rows[j] = std::min(static_cast<int>(j), cap);
+    }
+
+    std::vector<std::pair<int, WordId>> matches; // (distance, record), found in key order
+    const TrieNode &rootNode = nodes.get(root);
+    if (rootNode.isEndOfWord && rows[width - 1] <= maxEdits)
+    {
+        matches.emplace_back(rows[width - 1], rootNode.wordId);
+    }
+
+    std::vector<TrieFuzzyStep> stack;
+    char key;
+    for (int slot = rootNode.getSlotCount() - 1; slot >= 0; slot--)
+    {
+        NodeIndex child = getChildAt(root, slot, key);
+        if (child != NULL_NODE)
+        {
+            stack.push_back(TrieFuzzyStep{child, 1, key});
+        }
     }
 
-    // Recursively destroy all child nodes first
-    for (auto &pair : node->children)
+    while (!stack.empty())
     {
-        destroyTrie(pair.second);
+        TrieFuzzyStep next = stack.back();
+        stack.pop_back();
+
+        size_t depth = static_cast<size_t>(next.depth);
+        if ((depth + 1) * width > rows.size())
+        {
+            rows.resize(rows.size() * 2, cap);
+        }
+        const int *above = rows.data() + (depth - 1) * width;
+        int *row = rows.data() + depth * width;
+
+        // Only the band |depth - j| <= maxEdits can stay within the bound; the
+        // cells just outside it are set to the cap so the next row reads them safely
+        size_t low = (depth > static_cast<size_t>(maxEdits)) ? depth - maxEdits : 1;
+        size_t high = std::min(width - 1, depth + maxEdits);
+        row[low - 1] = (low == 1) ? std::min(static_cast<int>(depth), cap) : cap;
+        if (high + 1 < width)
+        {
+            row[high + 1] = cap;
+        }
+
+        int rowMin = row[low - 1];
+        for (size_t j = low; j <= high; j++)
+        {
+            int substitute = above[j - 1] + (query[j - 1] == next.key ? 0 : 1);
+            int remove = above[j] + 1;
+            int insert = row[j - 1] + 1;
+            row[j] = std::min(std::min(substitute, std::min(remove, insert)), cap);
+            rowMin = std::min(rowMin, row[j]);
+        }
+        if (rowMin > maxEdits)
+        {
+            continue; // No extension of this path can come back within the bound
+        }
+
+        const TrieNode &current = nodes.get(next.node);
+        if (current.isEndOfWord && row[width - 1] <= maxEdits)
+        {
+            matches.emplace_back(row[width - 1], current.wordId);
+        }
+
+        // Read the slot run directly (a run never straddles chunks)
+        int slotCount = current.getSlotCount();
+        const NodeIndex *run = (slotCount > 0) ? &slotArena.get(current.slots) : nullptr;
+        for (int slot = slotCount - 1; slot >= 0; slot--)
+        {
+            if (run[slot] != NULL_NODE)
+            {
+                stack.push_back(TrieFuzzyStep{run[slot], next.depth + 1, current.getSlotKey(slot)});
+            }
+        }
     }
 
-    // Then destroy the current node
-    delete node;
+    // Closest first; the walk already produced each distance in key order
+    std::stable_sort(matches.begin(), matches.end(), [](const std::pair<int, WordId> &a, const std::pair<int, WordId> &b)
+                     { return a.first < b.first; });
+
+    int delivered = 0;
+    for (const auto &match : matches)
+    {
+        if (delivered == limit)
+        {
+            break;
+        }
+        callback(store->get(match.second), match.first);
+        delivered++;
+    }
+    return delivered;
 }
 
 // =========================================
-// INSERTION OPERATION
+// PATTERN SEARCH
 // =========================================
 
 /**
- * Inserts a word into the Trie structure
- * Converts each character to lowercase for case-insensitive searching
- * Time Complexity: O(m) where m is the length of the word
- * @param word: Word object containing the word, part of speech, and definition
+ * TriePatternStep - Node waiting on the pattern search stack
  */
-void Trie::insert(const Word &word)
+struct TriePatternStep
 {
-    TrieNode *current = root;
-    std::string name = word.getWord();
+    NodeIndex node;
+    int depth; // Depth of node (1 = child of the root)
+    char key;  // Character on the edge into node
+};
 
-    // Traverse through each character of the word
-    for (char c : name)
+/**
+ * Adds the positions reachable through '*' without consuming a character
+ * (a star may match the empty run, so position p + 1 is active too)
+ * @param pattern: Lowercased pattern
+ * @param set: Bit set of active positions, pattern.size() + 1 bits
+ */
+static void closeOverStars(const std::string &pattern, uint64_t *set)
+{
+    for (size_t p = 0; p < pattern.size(); p++)
     {
-        // Convert to lowercase for case-insensitive search capability
-        char lowerC = tolower(c);
+        if (pattern[p] == '*' && (set[p >> 6] >> (p & 63) & 1))
+        {
+            set[(p + 1) >> 6] |= uint64_t(1) << ((p + 1) & 63);
+        }
+    }
+}
+
+/**
+ * Streams the words matching a wildcard pattern in lexicographic order
+ * The pattern runs as an NFA alongside a depth-first walk of the Trie: each node
+ * carries the set of pattern positions its path can be at, computed from its
+ * parent's set and its key, so every node is visited at most once and each
+ * match is reported once however many ways the stars can split it
+ * - A node whose set is empty is pruned with its whole subtree
+ * - A node whose active positions are all literal characters only looks up those
+ *   children; the full child list is scanned only under '?' or '*'
+ * Sets are bit rows in one flat buffer indexed by depth (as in fuzzySearch())
+ * @param pattern: Pattern with '?' (any one character) and '*' (any run, possibly empty)
+ * @param limit: Maximum number of results (negative = unlimited)
+ * @param nodeBudget: Maximum number of nodes to visit (negative = unlimited)
+ * @param callback: Called once per matching record
+ * @param budgetExceeded: Set to whether the walk stopped on the budget (may be nullptr)
+ * @return: Number of results delivered
+ */
+int Trie::matchPattern(const std::string &pattern, int limit, long long nodeBudget,
+                       const std::function<void(const Word &)> &callback, bool *budgetExceeded) const
+{
+    if (budgetExceeded != nullptr)
+    {
+        *budgetExceeded = false;
+    }
+    if (limit == 0)
+    {
+        return 0;
+    }
 
-        // If child node for this character doesn't exist, create it
-        if (current->children.find(lowerC) == current->children.end())
+    // Lowercase literals and collapse runs of stars (they match the same words)
+    std::string compiled;
+    for (char c : pattern)
+    {
+        if (c != '*' || compiled.empty() || compiled.back() != '*')
         {
-            current->children[lowerC] = new TrieNode();
-            nodeCount++; // Increment total node count
+            compiled.push_back(static_cast<char>(tolower(c)));
         }
+    }
+    const size_t length = compiled.size();
+    const size_t words = (length + 1 + 63) / 64; // 64-bit words per position set
 
-        // Move to the child node
-        current = current->children[lowerC];
+    std::vector<uint64_t> wildMask(words, 0); // Positions holding '?' or '*'
+    for (size_t p = 0; p < length; p++)
+    {
+        if (compiled[p] == '?' || compiled[p] == '*')
+        {
+            wildMask[p >> 6] |= uint64_t(1) << (p & 63);
+        }
     }
 
-    // Mark the last node as end of a valid word
-    current->isEndOfWord = true;
+    std::vector<uint64_t> sets(words * 16, 0);
+    sets[0] = 1;
+    closeOverStars(compiled, sets.data());
+
+    auto accepts = [length](const uint64_t *set)
+    { return (set[length >> 6] >> (length & 63) & 1) != 0; };
+
+    int delivered = 0;
+    long long visited = 0;
+    std::vector<TriePatternStep> stack;
+    std::vector<char> literals;
+
+    // Visits a node whose set is at depth; returns false once the search must stop
+    auto expand = [&](NodeIndex node, size_t depth) -> bool
+    {
+        const uint64_t *set = sets.data() + depth * words;
+        const TrieNode &current = nodes.get(node);
+        if (current.isEndOfWord && accepts(set))
+        {
+            callback(store->get(current.wordId));
+            delivered++;
+            if (delivered == limit)
+            {
+                return false;
+            }
+        }
+
+        bool wild = false;
+        for (size_t w = 0; w < words; w++)
+        {
+            wild = wild || (set[w] & wildMask[w]) != 0;
+        }
+
+        if (!wild)
+        {
+            // Only the literal characters at active positions can continue the match
+            literals.clear();
+            for (size_t p = 0; p < length; p++)
+            {
+                if (set[p >> 6] >> (p & 63) & 1)
+                {
+                    literals.push_back(compiled[p]);
+                }
+            }
+            std::sort(literals.begin(), literals.end(), [](char a, char b)
+                      { return static_cast<unsigned char>(a) > static_cast<unsigned char>(b); });
+            literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+            for (char c : literals)
+            {
+                NodeIndex child = findChild(node, c);
+                if (child != NULL_NODE)
+                {
+                    stack.push_back(TriePatternStep{child, static_cast<int>(depth) + 1, c});
+                }
+            }
+            return true;
+        }
+
+        int slotCount = current.getSlotCount();
+        const NodeIndex *run = (slotCount > 0) ? &slotArena.get(current.slots) : nullptr;
+        for (int slot = slotCount - 1; slot >= 0; slot--)
+        {
+            if (run[slot] != NULL_NODE)
+            {
+                stack.push_back(TriePatternStep{run[slot], static_cast<int>(depth) + 1, current.getSlotKey(slot)});
+            }
+        }
+        return true;
+    };
+
+    bool running = expand(root, 0);
+    while (running && !stack.empty())
+    {
+        if (nodeBudget >= 0 && visited >= nodeBudget)
+        {
+            if (budgetExceeded != nullptr)
+            {
+                *budgetExceeded = true;
+            }
+            break;
+        }
+
+        TriePatternStep next = stack.back();
+        stack.pop_back();
+        visited++;
+
+        size_t depth = static_cast<size_t>(next.depth);
+        if ((depth + 1) * words > sets.size())
+        {
+            sets.resize(sets.size() * 2, 0);
+        }
+        const uint64_t *above = sets.data() + (depth - 1) * words;
+        uint64_t *set = sets.data() + depth * words;
+
+        // Step every active position over next.key
+        bool any = false;
+        std::fill(set, set + words, 0);
+        for (size_t p = 0; p < length; p++)
+        {
+            if (!(above[p >> 6] >> (p & 63) & 1))
+            {
+                continue;
+            }
+            char wanted = compiled[p];
+            if (wanted == '*')
+            {
+                set[p >> 6] |= uint64_t(1) << (p & 63); // The star absorbs the character
+                any = true;
+            }
+            else if (wanted == '?' || wanted == next.key)
+            {
+                set[(p + 1) >> 6] |= uint64_t(1) << ((p + 1) & 63);
+                any = true;
+            }
+        }
+        if (!any)
+        {
+            continue; // No way to continue the match below this node
+        }
+        closeOverStars(compiled, set);
 
-    // Store a copy of the complete Word object at this node
-    current->word = new Word(word);
+        running = expand(next.node, depth);
+    }
+    return delivered;
 }
 
 // =========================================
-// SEARCH OPERATION
+// FREEZING
 // =========================================
 
 /**
- * Searches for a word in the Trie
- * Case-insensitive search by converting to lowercase
- * Time Complexity: O(m) where m is the length of the word
- * @param name: The word to search for
- * @return: Pointer to the Word object if found, nullptr otherwise
+ * Converts the built Trie into a read-only double-array trie
+ * Call once loading is finished; later inserts are not reflected in the copy
+ * @return: DoubleArrayTrie with the same words and record IDs
  */
-Word *Trie::search(const std::string &name) const
+DoubleArrayTrie Trie::freeze() const
 {
-    TrieNode *current = root;
+    return DoubleArrayTrie(*store, *this);
+}
 
-    // Traverse through each character of the search word
-    for (char c : name)
+// =========================================
+// SNAPSHOT
+// =========================================
+
+/**
+ * Adds the nodes and slot runs to a snapshot
+ * A breadth-first walk renumbers nodes densely (root = 1) and copies each slot run
+ * at its current capacity, so the node layout and growth rules are unchanged
+ * Element 0 of both arrays is the unused NULL_NODE slot; param0 = node count
+ * @param writer: Snapshot being assembled
+ */
+void Trie::writeSnapshot(SnapshotWriter &writer) const
+{
+    std::vector<TrieNode> denseNodes(1);
+    std::vector<NodeIndex> denseSlots(1, NULL_NODE);
+    std::vector<NodeIndex> order(1, root); // Old indices in breadth-first order
+    denseNodes.reserve(static_cast<size_t>(nodeCount) + 2);
+
+    for (size_t i = 0; i < order.size(); i++)
     {
-        // Convert to lowercase to match insertion format
-        char lowerC = tolower(c);
+        TrieNode copy = nodes.get(order[i]);
 
-        // If the character path doesn't exist, word is not in the Trie
-        if (current->children.find(lowerC) == current->children.end())
+        if (copy.slotCapacity != 0)
         {
-            return nullptr; // Word not found
+            int capacity = (copy.slotCapacity == TrieNode::DIRECT_LAYOUT) ? 256 : copy.slotCapacity;
+            NodeIndex run = static_cast<NodeIndex>(denseSlots.size());
+            denseSlots.resize(denseSlots.size() + capacity, NULL_NODE);
+
+            for (int slot = 0; slot < copy.getSlotCount(); slot++)
+            {
+                NodeIndex child = slotArena.get(copy.slots + slot);
+                if (child != NULL_NODE)
+                {
+                    order.push_back(child);
+                    denseSlots[run + slot] = static_cast<NodeIndex>(order.size());
+                }
+            }
+            copy.slots = run;
         }
+        denseNodes.push_back(copy);
+    }
+
+    writer.addSection(SnapshotSection::TRIE_NODES, denseNodes.data(), denseNodes.size() * sizeof(TrieNode),
+                      denseNodes.size(), static_cast<uint64_t>(nodeCount));
+    writer.addSection(SnapshotSection::TRIE_SLOTS, denseSlots.data(), denseSlots.size() * sizeof(NodeIndex),
+                      denseSlots.size());
+}
 
-        // Move to the next node in the path
-        current = current->children.at(lowerC);
+/**
+ * Uses the snapshot's node and slot arrays in place as this (empty) Trie's arenas
+ * Slot runs may straddle chunk boundaries here, which is fine: the adopted array is contiguous
+ * @param reader: Validated snapshot, already attached to the WordStore
+ * @return: False if the Trie isn't empty or the sections are missing or inconsistent
+ */
+bool Trie::readSnapshot(const SnapshotReader &reader)
+{
+    if (nodeCount != 0 || !checkSnapshot(reader, static_cast<uint32_t>(store->size())))
+    {
+        return false;
     }
 
-    // Return the word only if we're at a valid end-of-word node
-    return (current != nullptr && current->isEndOfWord) ? current->word : nullptr;
+    const SnapshotSectionEntry *nodeSection = reader.find(SnapshotSection::TRIE_NODES);
+    const SnapshotSectionEntry *slotSection = reader.find(SnapshotSection::TRIE_SLOTS);
+
+    nodes.clear();
+    slotArena.clear();
+    cursors = Cursors();
+    if (!nodes.adopt(reinterpret_cast<TrieNode *>(reader.data(*nodeSection)), nodeSection->count) ||
+        !slotArena.adopt(reinterpret_cast<NodeIndex *>(reader.data(*slotSection)), slotSection->count))
+    {
+        return false;
+    }
+
+    root = 1;
+    nodeCount = static_cast<int>(nodeSection->param0);
+    return true;
+}
+
+/**
+ * Checks the node and slot sections before anything uses them
+ * Every node needs a valid layout, a slot run inside the slot section and, if it
+ * ends a word, a record ID inside the store. Nodes are numbered breadth-first, so
+ * every child index is greater than its parent's: requiring that rules out cycles
+ * as well as out-of-range children
+ * @param reader: Validated snapshot
+ * @param recordCount: Number of records in the snapshot's WordStore
+ * @return: True if readSnapshot() would accept them
+ */
+bool Trie::checkSnapshot(const SnapshotReader &reader, uint32_t recordCount)
+{
+    const SnapshotSectionEntry *nodeSection = reader.find(SnapshotSection::TRIE_NODES);
+    const SnapshotSectionEntry *slotSection = reader.find(SnapshotSection::TRIE_SLOTS);
+    if (nodeSection == nullptr || slotSection == nullptr || nodeSection->count < 2 ||
+        nodeSection->param0 != nodeSection->count - 2 || slotSection->count == 0)
+    {
+        return false;
+    }
+
+    const TrieNode *denseNodes = reinterpret_cast<const TrieNode *>(reader.data(*nodeSection));
+    const NodeIndex *denseSlots = reinterpret_cast<const NodeIndex *>(reader.data(*slotSection));
+    for (uint32_t i = 1; i < nodeSection->count; i++)
+    {
+        const TrieNode &node = denseNodes[i];
+        if (node.isEndOfWord && node.wordId >= recordCount)
+        {
+            return false;
+        }
+        if (node.slotCapacity == 0)
+        {
+            if (node.childCount != 0)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        uint8_t capacity = node.slotCapacity;
+        bool direct = (capacity == TrieNode::DIRECT_LAYOUT);
+        if ((!direct && (capacity > TrieNode::SMALL_LIMIT || (capacity & (capacity - 1)) != 0 ||
+                         node.childCount > capacity)) ||
+            (direct && node.childCount > 256))
+        {
+            return false;
+        }
+
+        uint32_t runLength = direct ? 256 : capacity;
+        if (node.slots == NULL_NODE || static_cast<uint64_t>(node.slots) + runLength > slotSection->count)
+        {
+            return false;
+        }
+        for (int slot = 0; slot < node.getSlotCount(); slot++)
+        {
+            NodeIndex child = denseSlots[node.slots + slot];
+            if (child != NULL_NODE && (child <= i || child >= nodeSection->count))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 // =========================================
@@ -156,7 +1569,7 @@ Word *Trie::search(const std::string &name) const
  * @param result: Reference parameter to store the search result
  * @return: Time taken for the search in nanoseconds
  */
-long long Trie::searchWithTiming(const std::string &name, Word *&result)
+long long Trie::searchWithTiming(const std::string &name, const Word *&result)
 {
     // Record start time with high precision
     auto start = std::chrono::high_resolution_clock::now();
@@ -177,74 +1590,89 @@ long long Trie::searchWithTiming(const std::string &name, Word *&result)
 // =========================================
 
 /**
- * Calculates total memory usage of the Trie
- * @return: Total memory in bytes
+ * Calculates the memory used by the Trie index (node arena and slot arena)
+ * Word records are owned by the WordStore and reported there
+ * @return: Total memory in bytes (whole chunks, including outgrown slot runs)
  */
-int Trie::getMemoryUsage() const
+long long Trie::getMemoryUsage() const
 {
-    return getMemorySize(root);
+    return nodes.getMemoryUsage() + slotArena.getMemoryUsage() +
+           static_cast<long long>(topCacheNodes.capacity() * sizeof(NodeIndex) + topCacheIds.capacity() * sizeof(WordId));
 }
 
 /**
- * Recursively calculates memory size of the Trie starting from a node
- * Includes: node size, map overhead, Word object size, and string capacities
- * @param node: Current node being measured
- * @return: Memory size in bytes
+ * Returns the total number of nodes in the Trie
+ * @return: Node count
  */
-int Trie::getMemorySize(TrieNode *node) const
+int Trie::getNodeCount() const
 {
-    if (node == nullptr)
-    {
-        return 0;
-    }
-
-    // Base size of the TrieNode structure
-    int size = sizeof(TrieNode);
-
-    // Memory for the children map
-    // Unordered_map has approximately 16 bytes overhead per entry (more efficient than map's ~32 bytes)
-    // Each entry contains: key (char) + value (TrieNode*) + internal bookkeeping
-    size += node->children.size() * (sizeof(char) + sizeof(TrieNode *) + 16);
+    return nodeCount;
+}
 
-    // If this node stores a complete word, add its memory
-    if (node->word != nullptr)
-    {
-        size += sizeof(Word);
-        // Add the actual string storage capacity (not just length)
-        size += node->word->getWord().capacity();
-        size += node->word->getPartOfSpeech().capacity();
-        size += node->word->getDefinition().capacity();
-    }
+// =========================================
+// READ-ONLY TRAVERSAL
+// =========================================
 
-    // Recursively add memory of all child nodes
-    for (auto &pair : node->children)
-    {
-        size += getMemorySize(pair.second);
-    }
+/**
+ * Returns the root node
+ * @return: Index of the root
+ */
+NodeIndex Trie::getRoot() const
+{
+    return root;
+}
 
-    return size;
+/**
+ * Resolves a node index
+ * @param node: Node index
+ * @return: The node
+ */
+const TrieNode &Trie::getNode(NodeIndex node) const
+{
+    return nodes.get(node);
 }
 
 /**
- * Returns the total number of nodes in the Trie
- * @return: Node count
+ * Returns the child in a slot; slots are visited in character order
+ * @param node: Parent node
+ * @param slot: Slot index in [0, getNode(node).getSlotCount())
+ * @param key: Set to the slot's character
+ * @return: Child node, or NULL_NODE if the (direct layout) slot is empty
  */
-int Trie::getNodeCount() const
+NodeIndex Trie::getChildAt(NodeIndex node, int slot, char &key) const
 {
-    return nodeCount;
+    const TrieNode &parent = nodes.get(node);
+    key = parent.getSlotKey(slot);
+    return slotArena.get(parent.slots + slot);
 }
 
 // =========================================
 // DISPLAY FUNCTIONS
 // =========================================
 
+/**
+ * Displays every word in the Trie in lexicographic order, one per line
+ */
+void Trie::displayAllWords() const
+{
+    if (nodeCount == 0)
+    {
+        std::cout << "Trie is empty!" << std::endl;
+        return;
+    }
+
+    int count = getAllWordsHelper(root, -1, [](const Word &word)
+                                  { std::cout << word.getWord() << std::endl; });
+    std::cout << "(" << count << " words)" << std::endl;
+}
+
 /**
  * Displays the Trie structure in a tree-like format
  * Shows only the first 10 words to prevent overwhelming output
  */
 void Trie::displayTree() const
 {
-    if (root == nullptr)
+    if (nodeCount == 0)
     {
         std::cout << "Trie is empty!" << std::endl;
         return;
@@ -268,18 +1696,19 @@ void Trie::displayTree() const
  * @param count: Current count of words displayed (reference)
  * @param maxCount: Maximum number of words to display
  */
-void Trie::displayTreeHelper(TrieNode *node, std::string prefix, std::string charPrefix, int &count, int maxCount) const
+void Trie::displayTreeHelper(NodeIndex node, std::string prefix, std::string charPrefix, int &count, int maxCount) const
 {
     // Base cases: null node or reached display limit
-    if (node == nullptr || count >= maxCount)
+    if (node == NULL_NODE || count >= maxCount)
     {
         return;
     }
 
     // If this node marks the end of a word, display the complete word
-    if (node->isEndOfWord && node->word != nullptr)
+    const TrieNode &current = nodes.get(node);
+    if (current.isEndOfWord)
     {
-        std::cout << prefix << "+-- [" << node->word->getWord() << "]" << std::endl;
+        std::cout << prefix << "+-- [" << store->get(current.wordId).getWord() << "]" << std::endl;
         count++;
         if (count >= maxCount)
         {
@@ -288,27 +1717,32 @@ void Trie::displayTreeHelper(TrieNode *node, std::string prefix, std::string cha
         return; // Don't show children of complete words for cleaner output
     }
 
-    // Process all child nodes
-    int childCount = node->children.size();
+    // Process all child nodes (in character order)
+    int childCount = current.childCount;
     int currentChild = 0;
 
-    for (auto &pair : node->children)
+    for (int slot = 0; slot < current.getSlotCount(); slot++)
     {
         if (count >= maxCount)
             break;
 
+        char key;
+        NodeIndex child = getChildAt(node, slot, key);
+        if (child == NULL_NODE)
+            continue;
+
         currentChild++;
         bool isLast = (currentChild == childCount);
 
         // Display the character with appropriate tree branch symbol
         std::cout << prefix;
         std::cout << (isLast ? "+-- " : "|-- ");
-        std::cout << "'" << pair.first << "'" << std::endl;
+        std::cout << "'" << key << "'" << std::endl;
 
         // Recursively display child node with updated prefix for tree formatting
-        displayTreeHelper(pair.second,
+        displayTreeHelper(child,
                           prefix + (isLast ? "    " : "|   "),
-                          charPrefix + pair.first,
+                          charPrefix + key,
                           count,
                           maxCount);
     }
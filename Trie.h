@@ -1,49 +1,145 @@
 #ifndef TRIE_H
 #define TRIE_H
 
-#include "Word.h"
+#include "WordStore.h"
+#include "DoubleArrayTrie.h"
+#include "NodePool.h"
+#include "Snapshot.h"
+#include "EpochManager.h"
+#include <atomic>
 #include <chrono>
-#include <unordered_map>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <vector>
 
+/**
+ * TrieNode - Node in the Trie with an adaptive child layout (ART-style)
+ * - Small (up to 16 children): sorted keys stored inline in the node and scanned
+ *   with one SSE2 compare, child indices in a slot run sized 1/2/4/8/16
+ * - Direct (more than 16 children): 256-entry slot run indexed by character
+ * Nodes and slot runs live in the owning Trie's arenas and refer to each other by
+ * 32-bit NodeIndex; a lookup touches the 32-byte node plus one line of its slot run
+ * Each node also keeps the highest record weight in its subtree for top-k autocomplete
+ */
 class TrieNode
 {
 public:
-    std::unordered_map<char, TrieNode *> children; // Using unordered_map for better memory efficiency
-    Word *word;
+    static const int SMALL_LIMIT = 16;       // Max children before switching to direct indexing
+    static const uint8_t DIRECT_LAYOUT = 255; // slotCapacity value marking the direct layout
+
+    unsigned char keys[SMALL_LIMIT]; // Sorted child keys (small layout only)
+    NodeIndex slots;                 // First entry of the slot run (parallel to keys, or 256 direct entries)
+    WordId wordId;                   // Record ID in the WordStore (valid if isEndOfWord)
+    uint32_t maxWeight;              // Highest WordStore weight of any word in this subtree
+    uint16_t childCount;             // Number of children
+    uint8_t slotCapacity;            // Capacity of the slot run (0, 1, 2, 4, 8, 16 or DIRECT_LAYOUT)
     bool isEndOfWord;
 
     TrieNode();
-    ~TrieNode();
+
+    int findSlot(char key) const;     // Slot that holds key, -1 if absent (direct layout: always the key)
+    int getSlotCount() const;         // Slots to visit with Trie::getChildAt
+    char getSlotKey(int slot) const;  // Character of a slot; slots are in key order
 };
 
 class Trie
 {
 private:
-    TrieNode *root;
+    // Allocation positions in both arenas; one per inserting thread
+    struct Cursors
+    {
+        NodePool<TrieNode>::Cursor nodes;
+        NodePool<NodeIndex>::Cursor slots;
+    };
+
+    // Node (and slot run) replaced by a concurrent insertion, reusable once no reader can see it
+    struct Retired
+    {
+        uint64_t epoch;     // Epoch the node was unlinked in
+        NodeIndex node;
+        NodeIndex slots;    // Slot run retired with the node (NULL_NODE if it is still shared)
+        uint32_t runLength; // Length of that run
+    };
+
+    const WordStore *store;        // Shared record store that node IDs refer to
+    NodePool<TrieNode> nodes;      // Node arena
+    NodePool<NodeIndex> slotArena; // Child slot runs (outgrown runs stay until the arena is released)
+    Cursors cursors;               // Cursors for serial insertion
+    std::atomic<NodeIndex> root;   // Replaced atomically by concurrent insertions
     int nodeCount;
 
+    // Concurrent mode (epochs == nullptr: plain in-place updates)
+    EpochManager *epochs;            // Reader epochs guarding unlinked nodes
+    std::mutex writerMutex;          // Serializes writers (readers never take it)
+    std::vector<NodeIndex> copyPath; // Reused path of a concurrent insertion (node per depth)
+    std::deque<Retired> retired;     // Unlinked nodes in epoch order
+
+    static const int TOP_CACHE_SIZE = 16; // Completions cached per high-fanout node
+    std::vector<NodeIndex> topCacheNodes; // Direct-layout nodes with a cached top list (sorted)
+    std::vector<WordId> topCacheIds;      // TOP_CACHE_SIZE IDs per cached node, heaviest first, INVALID_ID padded
+
     // Helper functions
-    void destroyTrie(TrieNode *node);
-    int getMemorySize(TrieNode *node) const;
-    void getAllWordsHelper(TrieNode *node, std::string prefix, int &count, int maxCount) const;
-    void displayTreeHelper(TrieNode *node, std::string prefix, std::string charPrefix, int &count, int maxCount) const;
+    NodeIndex findChild(NodeIndex node, char key) const;                                // NULL_NODE if absent
+    NodeIndex getOrAddChild(NodeIndex node, char key, bool &created, Cursors &cursors); // Creates the child if absent
+    void addChild(NodeIndex node, char key, NodeIndex child, Cursors &cursors);        // key must be absent
+    uint32_t runLengthOf(const TrieNode &node) const;                                  // Entries in the node's slot run
+    NodeIndex copyWithChild(NodeIndex node, char key, NodeIndex child);                // Private copy, key -> child
+    void insertConcurrent(WordId id);                                                  // Path copy + atomic root swap
+    void reclaimRetired();                                                             // Recycles unreachable nodes
+    uint32_t subtreeMaxOf(NodeIndex node) const;                                       // From own word and children
+    int insertBelow(NodeIndex start, std::string_view name, size_t depth, WordId id, Cursors &cursors);
+    int getAllWordsHelper(NodeIndex start, int limit, const std::function<void(const Word &)> &callback) const;
+    int topCompletionsBelow(NodeIndex start, int k, const std::function<void(const Word &, uint32_t)> &callback) const;
+    const WordId *findTopCache(NodeIndex node) const; // nullptr if the node has no cached list
+    void displayTreeHelper(NodeIndex node, std::string prefix, std::string charPrefix, int &count, int maxCount) const;
 
 public:
-    // Constructor & Destructor
-    Trie();
-    ~Trie();
+    // Constructor (both arenas are released in O(chunks) on destruction)
+    Trie(const WordStore &store, bool hugePages = false);
 
     // Main operations
-    void insert(const Word &word);
-    Word *search(const std::string &name) const;
+    void insert(WordId id);
+    void insertAll(const std::vector<WordId> &ids, int threadCount); // Parallel by first character
+    // Concurrent mode: insert() copies the path and swaps the root, so readers holding an
+    // EpochGuard never block; drops the top-k cache (updateMaxWeights is not concurrent-safe)
+    void enableConcurrentUpdates(EpochManager &epochs);
+    const Word *search(const std::string &name) const;
+    void searchBatch(const std::string_view *names, size_t count, const Word **results) const; // Interleaved search()
+    // Streams words starting with prefix in lexicographic order; limit < 0 = unlimited; returns count
+    int forEachWithPrefix(const std::string &prefix, int limit,
+                          const std::function<void(const Word &)> &callback) const;
+    // Streams the k heaviest words starting with prefix, heaviest first (equal weights in no set order)
+    int forEachTopCompletion(const std::string &prefix, int k,
+                             const std::function<void(const Word &, uint32_t)> &callback) const;
+    void updateMaxWeights(); // Recomputes every subtree maximum after WordStore weights change
+    // Words within maxEdits Levenshtein edits (case-insensitive), closest first, then alphabetical
+    int fuzzySearch(const std::string &word, int maxEdits, int limit,
+                    const std::function<void(const Word &, int)> &callback) const;
+    // Words matching a pattern with '?' (one char) and '*' (any run), case-insensitive, in key order;
+    // stops after limit results or nodeBudget visited nodes (then sets *budgetExceeded)
+    int matchPattern(const std::string &pattern, int limit, long long nodeBudget,
+                     const std::function<void(const Word &)> &callback, bool *budgetExceeded = nullptr) const;
+    DoubleArrayTrie freeze() const; // Read-only BASE/CHECK copy for serving; this Trie is unchanged
+
+    // Snapshot (nodes and slot runs renumbered breadth-first, used in place when read)
+    void writeSnapshot(SnapshotWriter &writer) const;
+    bool readSnapshot(const SnapshotReader &reader); // False unless empty and the sections are present and consistent
+    static bool checkSnapshot(const SnapshotReader &reader, uint32_t recordCount); // Validates without adopting
 
     // Performance metrics
-    long long searchWithTiming(const std::string &name, Word *&result);
-    int getMemoryUsage() const;
+    long long searchWithTiming(const std::string &name, const Word *&result);
+    long long getMemoryUsage() const;
     int getNodeCount() const;
 
+    // Read-only traversal (used by DoubleArrayTrie)
+    NodeIndex getRoot() const;
+    const TrieNode &getNode(NodeIndex node) const;
+    NodeIndex getChildAt(NodeIndex node, int slot, char &key) const; // NULL_NODE for an empty slot
+
     // Display
-    void displayAllWords() const;
+    void displayAllWords() const; // Every word, in lexicographic order
     void displayTree() const;
 };
 
@@ -6,19 +6,19 @@
 
 /**
  * Default Constructor
- * Initializes all string fields to empty strings
+ * Initializes all fields to empty views
  */
-Word::Word() : word(""), partOfSpeech(""), definition("") {}
+Word::Word() : word(), partOfSpeech(), definition() {}
 
 /**
  * Parameterized Constructor
- * Initializes Word with specified values
+ * Initializes Word as a view of the specified text (no copies are made)
  * @param word: The word text
  * @param partOfSpeech: Part of speech label
  * @param definition: The word's definition
  */
-Word::Word(const std::string &word, const std::string &partOfSpeech,
-           const std::string &definition)
+Word::Word(std::string_view word, std::string_view partOfSpeech,
+           std::string_view definition)
     : word(word), partOfSpeech(partOfSpeech), definition(definition) {}
 
 // =========================================
@@ -26,28 +26,28 @@ Word::Word(const std::string &word, const std::string &partOfSpeech,
 // =========================================
 
 /**
- * Returns the word text
- * @return: The word as a string
+ * Returns the word text without copying it
+ * @return: View of the word text
  */
-std::string Word::getWord() const
+std::string_view Word::getWord() const
 {
     return word;
 }
 
 /**
- * Returns the part of speech
- * @return: Part of speech as a string
+ * Returns the part of speech without copying it
+ * @return: View of the part of speech
  */
-std::string Word::getPartOfSpeech() const
+std::string_view Word::getPartOfSpeech() const
 {
     return partOfSpeech;
 }
 
 /**
- * Returns the definition
- * @return: Definition as a string
+ * Returns the definition without copying it
+ * @return: View of the definition
  */
-std::string Word::getDefinition() const
+std::string_view Word::getDefinition() const
 {
     return definition;
 }
@@ -60,7 +60,7 @@ std::string Word::getDefinition() const
  * Sets the word text
  * @param word: New word text to set
  */
-void Word::setWord(const std::string &word)
+void Word::setWord(std::string_view word)
 {
     this->word = word;
 }
@@ -69,7 +69,7 @@ void Word::setWord(const std::string &word)
  * Sets the part of speech
  * @param partOfSpeech: New part of speech to set
  */
-void Word::setPartOfSpeech(const std::string &partOfSpeech)
+void Word::setPartOfSpeech(std::string_view partOfSpeech)
 {
     this->partOfSpeech = partOfSpeech;
 }
@@ -78,7 +78,7 @@ void Word::setPartOfSpeech(const std::string &partOfSpeech)
  * Sets the definition
  * @param definition: New definition to set
  */
-void Word::setDefinition(const std::string &definition)
+void Word::setDefinition(std::string_view definition)
 {
     this->definition = definition;
 }
@@ -2,77 +2,84 @@
 #define WORD_H
 
 #include <string>
+#include <string_view>
 #include <iostream>
 
 /**
  * Word - Represents a dictionary word entry
  * Stores the word text, its part of speech, and definition
+ * Word is a lightweight, non-owning view: the three fields point at text owned
+ * elsewhere (normally the WordStore's mapped dictionary file or text arena),
+ * so copying a Word never copies or allocates strings
  */
 class Word
 {
 private:
-    std::string word;         // The word itself (e.g., "Apple")
-    std::string partOfSpeech; // Part of speech (e.g., "n." for noun, "v." for verb)
-    std::string definition;   // The word's definition
+    std::string_view word;         // The word itself (e.g., "Apple")
+    std::string_view partOfSpeech; // Part of speech (e.g., "n." for noun, "v." for verb)
+    std::string_view definition;   // The word's definition
 
 public:
     // === CONSTRUCTORS ===
 
     /**
      * Default constructor
-     * Creates an empty Word with all fields as empty strings
+     * Creates an empty Word with all fields as empty views
      */
     Word();
 
     /**
      * Parameterized constructor
-     * Creates a Word with specified values
+     * Creates a Word viewing the specified text (the text is not copied and
+     * must outlive this Word)
      * @param word: The word text
      * @param partOfSpeech: Part of speech label
      * @param definition: The word's definition
      */
-    Word(const std::string &word, const std::string &partOfSpeech,
-         const std::string &definition);
+    Word(std::string_view word, std::string_view partOfSpeech,
+         std::string_view definition);
 
     // === GETTERS ===
+    // Getters return views so lookups never copy (or allocate) strings
 
     /**
      * Gets the word text
-     * @return: The word as a string
+     * @return: View of the word text
      */
-    std::string getWord() const;
+    std::string_view getWord() const;
 
     /**
      * Gets the part of speech
-     * @return: Part of speech as a string
+     * @return: View of the part of speech
      */
-    std::string getPartOfSpeech() const;
+    std::string_view getPartOfSpeech() const;
 
     /**
      * Gets the definition
-     * @return: Definition as a string
+     * @return: View of the definition
      */
-    std::string getDefinition() const;
+    std::string_view getDefinition() const;
 
     // === SETTERS ===
+    // Setters re-point the view; the new text must outlive this Word
 
     /**
      * Sets the word text
      * @param word: New word text
      */
-    void setWord(const std::string &word);
+    void setWord(std::string_view word);
 
     /**
      * Sets the part of speech
      * @param partOfSpeech: New part of speech
      */
-    void setPartOfSpeech(const std::string &partOfSpeech);
+    void setPartOfSpeech(std::string_view partOfSpeech);
 
     /**
      * Sets the definition
      * @param definition: New definition
      */
-    void setDefinition(const std::string &definition);
+    void setDefinition(std::string_view definition);
 
     // === DISPLAY ===
 
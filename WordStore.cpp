@@ -0,0 +1,299 @@
+#include "WordStore.h"
+
+#include <cstring>
+
+/**
+ * SnapshotRecord - One record in the STORE_RECORDS snapshot section
+ * Offsets are relative to the start of the STORE_TEXT section
+ */
+struct SnapshotRecord
+{
+    uint32_t wordOffset;
+    uint32_t wordLength;
+    uint32_t partOfSpeechOffset;
+    uint32_t partOfSpeechLength;
+    uint32_t definitionOffset;
+    uint32_t definitionLength;
+};
+
+static_assert(sizeof(SnapshotRecord) == 6 * sizeof(uint32_t), "snapshot record layout must be packed");
+
+// =========================================
+// CONSTRUCTOR
+// =========================================
+
+/**
+ * WordStore Constructor
+ * Creates an empty store with no mapped files and an empty text arena
+ */
+WordStore::WordStore() : mappedTextBytes(0), textBlockUsed(0), textBlockSize(0), textBytes(0) {}
+
+// =========================================
+// MAIN OPERATIONS
+// =========================================
+
+/**
+ * Appends a record to the end of the store, copying its text into the arena
+ * Records are never removed or reordered, so IDs stay valid for the store's lifetime
+ * @param word: Word whose text should be stored
+ * @return: ID of the new record (its position in the array)
+ */
+WordId WordStore::add(const Word &word)
+{
+    records.emplace_back(copyText(word.getWord()),
+                         copyText(word.getPartOfSpeech()),
+                         copyText(word.getDefinition()));
+    return static_cast<WordId>(records.size() - 1);
+}
+
+/**
+ * Appends a record that views text inside a mapped file
+ * @param word: Word viewing text returned by mapFile()
+ * @return: ID of the new record (its position in the array)
+ */
+WordId WordStore::addMapped(const Word &word)
+{
+    records.push_back(word);
+    return static_cast<WordId>(records.size() - 1);
+}
+
+/**
+ * Maps a dictionary file and takes ownership of the mapping
+ * Records added with addMapped() may then view its contents directly
+ * @param filename: Path of the file to map
+ * @param text: Set to a view of the whole file on success
+ * @return: True on success, false if the file can't be opened
+ */
+bool WordStore::mapFile(const std::string &filename, std::string_view &text)
+{
+    std::unique_ptr<MappedFile> file(new MappedFile());
+    if (!file->open(filename))
+    {
+        return false;
+    }
+
+    text = std::string_view(file->getData(), file->getSize());
+    mappedTextBytes += file->getSize();
+    files.push_back(std::move(file));
+    return true;
+}
+
+/**
+ * Takes ownership of an already opened file
+ * Its bytes are not counted as record payload; readSnapshot counts the text section
+ * @param file: Opened file
+ */
+void WordStore::adoptFile(std::unique_ptr<MappedFile> file)
+{
+    files.push_back(std::move(file));
+}
+
+// =========================================
+// SNAPSHOT
+// =========================================
+
+/**
+ * Adds the record text (all fields back to back) and the record table to a snapshot
+ * @param writer: Snapshot being assembled
+ */
+void WordStore::writeSnapshot(SnapshotWriter &writer) const
+{
+    std::string text;
+    std::vector<SnapshotRecord> table;
+    table.reserve(records.size());
+
+    auto append = [&text](std::string_view field, uint32_t &offset, uint32_t &length)
+    {
+        offset = static_cast<uint32_t>(text.size());
+        length = static_cast<uint32_t>(field.size());
+        text.append(field.data(), field.size());
+    };
+
+    for (const Word &record : records)
+    {
+        SnapshotRecord entry;
+        append(record.getWord(), entry.wordOffset, entry.wordLength);
+        append(record.getPartOfSpeech(), entry.partOfSpeechOffset, entry.partOfSpeechLength);
+        append(record.getDefinition(), entry.definitionOffset, entry.definitionLength);
+        table.push_back(entry);
+    }
+
+    writer.addSection(SnapshotSection::STORE_TEXT, text.data(), text.size(), text.size());
+    writer.addSection(SnapshotSection::STORE_RECORDS, table.data(),
+                      table.size() * sizeof(SnapshotRecord), table.size());
+}
+
+/**
+ * Loads records from an open snapshot into an empty store
+ * @param reader: Validated snapshot
+ * @return: True on success, false if the store isn't empty or the sections are missing or inconsistent
+ */
+bool WordStore::readSnapshot(const SnapshotReader &reader)
+{
+    if (!records.empty() || !checkSnapshot(reader))
+    {
+        return false;
+    }
+
+    const SnapshotSectionEntry *textSection = reader.find(SnapshotSection::STORE_TEXT);
+    const SnapshotSectionEntry *recordSection = reader.find(SnapshotSection::STORE_RECORDS);
+    const char *text = reader.data(*textSection);
+    const SnapshotRecord *table = reinterpret_cast<const SnapshotRecord *>(reader.data(*recordSection));
+
+    records.reserve(recordSection->count);
+    for (uint32_t i = 0; i < recordSection->count; i++)
+    {
+        const SnapshotRecord &entry = table[i];
+        records.emplace_back(std::string_view(text + entry.wordOffset, entry.wordLength),
+                             std::string_view(text + entry.partOfSpeechOffset, entry.partOfSpeechLength),
+                             std::string_view(text + entry.definitionOffset, entry.definitionLength));
+    }
+
+    mappedTextBytes += static_cast<long long>(textSection->bytes);
+    return true;
+}
+
+/**
+ * Checks that both record sections are present and every field lies inside the text section
+ * @param reader: Validated snapshot
+ * @return: True if readSnapshot() would accept them
+ */
+bool WordStore::checkSnapshot(const SnapshotReader &reader)
+{
+    const SnapshotSectionEntry *textSection = reader.find(SnapshotSection::STORE_TEXT);
+    const SnapshotSectionEntry *recordSection = reader.find(SnapshotSection::STORE_RECORDS);
+    if (textSection == nullptr || recordSection == nullptr ||
+        recordSection->bytes != static_cast<uint64_t>(recordSection->count) * sizeof(SnapshotRecord))
+    {
+        return false;
+    }
+
+    const SnapshotRecord *table = reinterpret_cast<const SnapshotRecord *>(reader.data(*recordSection));
+    uint64_t textLength = textSection->bytes;
+    auto inText = [textLength](uint32_t offset, uint32_t length)
+    { return static_cast<uint64_t>(offset) + length <= textLength; };
+
+    for (uint32_t i = 0; i < recordSection->count; i++)
+    {
+        const SnapshotRecord &entry = table[i];
+        if (!inText(entry.wordOffset, entry.wordLength) ||
+            !inText(entry.partOfSpeechOffset, entry.partOfSpeechLength) ||
+            !inText(entry.definitionOffset, entry.definitionLength))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Copies text into the arena, starting a new block when the current one is full
+ * Blocks are never moved or freed before the store, so returned views stay valid
+ * @param text: Text to copy
+ * @return: View of the arena copy
+ */
+std::string_view WordStore::copyText(std::string_view text)
+{
+    if (text.empty())
+    {
+        return std::string_view();
+    }
+
+    if (textBlocks.empty() || textBlockUsed + text.size() > textBlockSize)
+    {
+        // Oversized text gets a block of its own
+        textBlockSize = (text.size() > TEXT_BLOCK_SIZE) ? text.size() : TEXT_BLOCK_SIZE;
+        textBlocks.emplace_back(new char[textBlockSize]);
+        textBlockUsed = 0;
+        textBytes += textBlockSize;
+    }
+
+    char *destination = textBlocks.back().get() + textBlockUsed;
+    std::memcpy(destination, text.data(), text.size());
+    textBlockUsed += text.size();
+
+    return std::string_view(destination, text.size());
+}
+
+/**
+ * Returns the record with the given ID
+ * @param id: Record ID returned by add()
+ * @return: Reference to the stored Word
+ */
+const Word &WordStore::get(WordId id) const
+{
+    return records[id];
+}
+
+/**
+ * Returns the ID of a record from its address (records are one contiguous array)
+ * @param record: Reference to a record of this store
+ * @return: Its record ID
+ */
+WordId WordStore::idOf(const Word &record) const
+{
+    return static_cast<WordId>(&record - records.data());
+}
+
+// =========================================
+// WEIGHTS
+// =========================================
+
+/**
+ * Sets the popularity weight of a record
+ * The weight array is only allocated once some record gets a weight
+ * @param id: Record ID
+ * @param weight: New weight
+ */
+void WordStore::setWeight(WordId id, uint32_t weight)
+{
+    if (weights.size() < records.size())
+    {
+        weights.resize(records.size(), 0);
+    }
+    weights[id] = weight;
+}
+
+/**
+ * Returns the popularity weight of a record
+ * @param id: Record ID
+ * @return: Weight, 0 if never set
+ */
+uint32_t WordStore::getWeight(WordId id) const
+{
+    return id < weights.size() ? weights[id] : 0;
+}
+
+/**
+ * Pre-allocates the record array so loading doesn't repeatedly reallocate
+ * @param count: Expected number of records
+ */
+void WordStore::reserve(int count)
+{
+    records.reserve(count);
+}
+
+// =========================================
+// METRICS
+// =========================================
+
+/**
+ * Returns the number of stored records
+ * @return: Record count
+ */
+int WordStore::size() const
+{
+    return static_cast<int>(records.size());
+}
+
+/**
+ * Calculates the memory used by the record payload
+ * Mapped record text counts at its full size (it is backed by the page cache, not the heap);
+ * the index sections of an adopted snapshot are reported by the indexes using them
+ * @return: Record and weight array capacity plus mapped text bytes plus arena blocks, in bytes
+ */
+long long WordStore::getMemoryUsage() const
+{
+    long long totalSize = records.capacity() * sizeof(Word) + weights.capacity() * sizeof(uint32_t);
+    return totalSize + mappedTextBytes + textBytes;
+}
@@ -0,0 +1,166 @@
+#ifndef WORDSTORE_H
+#define WORDSTORE_H
+
+#include "Word.h"
+#include "MappedFile.h"
+#include "Snapshot.h"
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * WordId - 32-bit handle of a record inside a WordStore
+ * Indexes store these instead of copies of Word objects
+ */
+typedef uint32_t WordId;
+
+/**
+ * WordStore - Central, append-only storage of dictionary records
+ * Owns every record exactly once in a contiguous array; BinaryTree and Trie
+ * reference records by WordId, so definitions are never duplicated
+ * Records are Word views into text the store also owns:
+ * - dictionary files mapped with mapFile() (zero-copy, no per-record allocation)
+ * - a block-allocated text arena for records added with add()
+ * - the text section of a snapshot adopted with readSnapshot()
+ * Note: pointers/references returned by get() are invalidated by add()/addMapped()
+ * unless reserve() left room; with concurrent readers (see EpochManager) the
+ * writer must reserve() first so appending never moves the record array
+ */
+class WordStore
+{
+private:
+    std::vector<Word> records;     // All records, indexed by WordId
+    std::vector<uint32_t> weights; // Optional popularity per record (empty until the first setWeight)
+
+    std::vector<std::unique_ptr<MappedFile>> files; // Mapped dictionary files and snapshots
+    long long mappedTextBytes;                       // Bytes of mapped files that hold record text
+    std::vector<std::unique_ptr<char[]>> textBlocks; // Arena blocks holding copied text
+    size_t textBlockUsed;                            // Bytes used in the newest arena block
+    size_t textBlockSize;                            // Capacity of the newest arena block
+    long long textBytes;                             // Total capacity of all arena blocks
+
+    static const size_t TEXT_BLOCK_SIZE = 64 * 1024; // Default arena block capacity
+
+    /**
+     * Copies text into the arena
+     * @param text: Text to copy
+     * @return: View of the arena copy (stable for the store's lifetime)
+     */
+    std::string_view copyText(std::string_view text);
+
+public:
+    static constexpr WordId INVALID_ID = 0xFFFFFFFFu; // Marks "no record"
+
+    // === CONSTRUCTOR ===
+    WordStore();
+
+    // === MAIN OPERATIONS ===
+
+    /**
+     * Appends a record, copying its text into the store's arena
+     * @param word: Word whose text should be stored
+     * @return: ID of the new record
+     */
+    WordId add(const Word &word);
+
+    /**
+     * Appends a record whose text already lives in a file mapped by this store
+     * No text is copied
+     * @param word: Word viewing text returned by mapFile()
+     * @return: ID of the new record
+     */
+    WordId addMapped(const Word &word);
+
+    /**
+     * Maps a dictionary file into memory and keeps it alive for the store's lifetime
+     * @param filename: Path of the file to map
+     * @param text: Set to a view of the whole file on success
+     * @return: True on success, false if the file can't be opened
+     */
+    bool mapFile(const std::string &filename, std::string_view &text);
+
+    /**
+     * Takes ownership of an already opened file (e.g. a snapshot mapping)
+     * so that structures using it in place stay valid for the store's lifetime
+     * @param file: Opened file
+     */
+    void adoptFile(std::unique_ptr<MappedFile> file);
+
+    // === SNAPSHOT ===
+
+    /**
+     * Adds the record text and the record table to a snapshot
+     * @param writer: Snapshot being assembled
+     */
+    void writeSnapshot(SnapshotWriter &writer) const;
+
+    /**
+     * Loads records from an open snapshot into an empty store
+     * Text is used in place; only the Word views are rebuilt (one O(n) pass,
+     * since a Word holds real string_views rather than offsets)
+     * @param reader: Validated snapshot
+     * @return: True on success, false if the store isn't empty or the sections are missing or inconsistent
+     */
+    bool readSnapshot(const SnapshotReader &reader);
+
+    /**
+     * Checks the record sections without loading them (every field inside the text)
+     * @param reader: Validated snapshot
+     * @return: True if readSnapshot() would accept them
+     */
+    static bool checkSnapshot(const SnapshotReader &reader);
+
+    /**
+     * Gets a record by ID
+     * @param id: Record ID returned by add()
+     * @return: Reference to the stored Word
+     */
+    const Word &get(WordId id) const;
+
+    /**
+     * Gets the ID of a record returned by get() or an index lookup
+     * @param record: Reference to a record of this store
+     * @return: Its record ID
+     */
+    WordId idOf(const Word &record) const;
+
+    // === WEIGHTS ===
+
+    /**
+     * Sets the popularity weight of a record (used to rank autocomplete results)
+     * @param id: Record ID
+     * @param weight: New weight (records default to 0)
+     */
+    void setWeight(WordId id, uint32_t weight);
+
+    /**
+     * Gets the popularity weight of a record
+     * @param id: Record ID
+     * @return: Weight, 0 if never set
+     */
+    uint32_t getWeight(WordId id) const;
+
+    /**
+     * Pre-allocates room for a number of records
+     * @param count: Expected number of records
+     */
+    void reserve(int count);
+
+    // === METRICS ===
+
+    /**
+     * Gets the number of stored records
+     * @return: Record count
+     */
+    int size() const;
+
+    /**
+     * Gets the memory used by the record payload
+     * Includes: the record array, mapped file bytes, and the text arena
+     * @return: Memory used in bytes
+     */
+    long long getMemoryUsage() const;
+};
+
+#endif
@@ -3,8 +3,11 @@
  *
  * This program demonstrates and compares two fundamental data structures
  * for dictionary word lookups:
- * 1. Binary Search Tree (BST) - Traditional tree-based approach
+ * 1. Binary Search Tree (BST) - Traditional tree-based approach (AVL balanced)
  * 2. Trie (Prefix Tree) - Optimized for string searching
+ *    (plus a path-compressed radix variant and a minimized DAWG for comparison)
+ * 3. Hash Index - Open-addressing (Swiss-table) hash table for exact lookups
+ *    (and a static Eytzinger-layout copy of the BST that serves ordered queries)
  *
  * Features:
  * - Load dictionary from file into both structures
@@ -24,26 +27,104 @@ using namespace std;
 /**
  * Main program entry point
  * Initializes both data structures, loads dictionary, and runs menu loop
+ * Batch use: "dictionary_search --prefix <prefix> [limit]" prints the matching
+ * words in lexicographic order, "dictionary_search --top <prefix> [k]" prints the
+ * k heaviest completions, "dictionary_search --range <lo> <hi> [limit]" prints the
+ * words between two keys alphabetically, "dictionary_search --fuzzy <word> [maxEdits]"
+ * prints the closest words, "dictionary_search --pattern <pattern> [limit]" prints the
+ * words matching a ? / * wildcard pattern, "dictionary_search --bench [file.json]" runs
+ * the performance comparison and writes its JSON results; all of them exit without
+ * showing the menu
+ * @param argc: Number of command-line arguments
+ * @param argv: Command-line arguments
  */
-int main()
+int main(int argc, char *argv[])
 {
-    // Initialize both data structures
-    BinaryTree tree; // Binary Search Tree
-    Trie trie;       // Trie (Prefix Tree)
+    // Initialize the shared record store and both data structures
+    // (declared first so it outlives the indexes that reference it)
+    WordStore store;                       // Owns every dictionary record exactly once
+    BinaryTree tree(store, TreeMode::AVL); // Self-balancing BST (dictionary.txt is sorted)
+    Trie trie(store);                      // Trie (Prefix Tree)
+    RadixTrie radix(store);                // Path-compressed Trie
+    Dawg dawg(store);                      // Minimized automaton (shared prefixes and suffixes)
+    DoubleArrayTrie frozenTrie(store);     // Read-only double-array copy of the Trie for serving
+    HashIndex hashIndex(store);            // Exact-match hash table over the headwords
 
     // Display welcome banner
     cout << "========================================" << endl;
     cout << "  DICTIONARY SEARCH PROGRAM INITIALIZED" << endl;
     cout << "========================================" << endl;
 
-    // Load dictionary words into both structures
-    loadWords("dictionary.txt", tree, trie);
+    // Map the snapshot if it is current; otherwise load the text file, freeze the
+    // Trie and write a snapshot for the next start
+    if (!loadSnapshot(SNAPSHOT_FILENAME, DICTIONARY_FILENAME, store, tree, trie, frozenTrie))
+    {
+        loadWords(DICTIONARY_FILENAME, store, tree, trie);
+        frozenTrie = trie.freeze();
+        saveSnapshot(SNAPSHOT_FILENAME, DICTIONARY_FILENAME, store, tree, trie, frozenTrie);
+    }
+
+    // The hash index and the ordered index are not part of the snapshot; both
+    // are rebuilt in one pass over the loaded words
+    hashIndex.indexAll();
+    EytzingerIndex sortedIndex(store, tree); // Read-only copy of the BST's order for range queries
+
+    // Optional popularity weights rank the top-k autocomplete
+    int weighted = loadWeights(WEIGHTS_FILENAME, store, trie);
+    if (weighted >= 0)
+    {
+        cout << "Applied " << weighted << " weight entries from " << WEIGHTS_FILENAME << endl;
+    }
 
-    // Test cases for performance comparison
-    // These are pre-selected words that exist in the dictionary
-    vector<string> testCases = {
-        "Awfully", "Chirographer", "Luminate", "Hexastich", "Preoccupy",
-        "Stanzaic", "Whot", "Restorationism", "Inkhornism", "Copper-nickel"};
+    // The radix trie and DAWG are only used for comparisons, so they are built on first use
+    bool comparisonIndexesBuilt = false;
+    auto buildComparisonIndexes = [&]()
+    {
+        if (!comparisonIndexesBuilt)
+        {
+            radix.indexAll();
+            dawg.build();
+            comparisonIndexesBuilt = true;
+        }
+    };
+
+    // Batch command: list the words with a prefix and exit
+    if (argc >= 3 && string(argv[1]) == "--prefix")
+    {
+        int limit = (argc >= 4) ? atoi(argv[3]) : -1;
+        printPrefixMatches(trie, argv[2], limit);
+        return 0;
+    }
+    if (argc >= 3 && string(argv[1]) == "--top")
+    {
+        int k = (argc >= 4) ? atoi(argv[3]) : 10;
+        printTopCompletions(trie, argv[2], k);
+        return 0;
+    }
+    if (argc >= 3 && string(argv[1]) == "--fuzzy")
+    {
+        int maxEdits = (argc >= 4) ? atoi(argv[3]) : 2;
+        printFuzzyMatches(trie, argv[2], maxEdits, -1);
+        return 0;
+    }
+    if (argc >= 3 && string(argv[1]) == "--pattern")
+    {
+        int limit = (argc >= 4) ? atoi(argv[3]) : -1;
+        printPatternMatches(trie, argv[2], limit, PATTERN_NODE_BUDGET);
+        return 0;
+    }
+    if (argc >= 2 && string(argv[1]) == "--bench")
+    {
+        buildComparisonIndexes();
+        comparePerformance(store, tree, trie, frozenTrie, radix, dawg, hashIndex, (argc >= 3) ? argv[2] : BENCHMARK_FILENAME);
+        return 0;
+    }
+    if (argc >= 4 && string(argv[1]) == "--range")
+    {
+        int limit = (argc >= 5) ? atoi(argv[4]) : -1;
+        printWordRange(sortedIndex, argv[2], argv[3], limit);
+        return 0;
+    }
 
     int choice;
 
@@ -56,7 +137,7 @@ int main()
         switch (choice)
         {
         case 1: // Search for a word
-            searchWord(tree, trie);
+            searchWord(tree, frozenTrie, hashIndex, trie);
             break;
 
         case 2: // Display Binary Tree structure
@@ -70,11 +151,57 @@ int main()
             break;
 
         case 4: // Compare performance
-            comparePerformance(tree, trie, testCases);
+            buildComparisonIndexes();
+            comparePerformance(store, tree, trie, frozenTrie, radix, dawg, hashIndex, BENCHMARK_FILENAME);
             break;
 
         case 5: // Display memory usage
-            displayMemoryUsage(tree, trie);
+            buildComparisonIndexes();
+            displayMemoryUsage(store, tree, trie, frozenTrie, radix, dawg, hashIndex);
+            break;
+
+        case 6: // Parallel load scaling benchmark
+            benchmarkLoadScaling(DICTIONARY_FILENAME);
+            break;
+
+        case 7: // Prefix search (alphabetical)
+            prefixSearch(trie);
+            break;
+
+        case 8: // Top-k autocomplete (by weight)
+            autocomplete(trie);
+            break;
+
+        case 9: // Browse words alphabetically
+            browseWords(sortedIndex);
+            break;
+
+        case 10: // Pattern search (? and * wildcards)
+            patternSearch(trie, PATTERN_NODE_BUDGET);
+            break;
+
+        case 11: // Batched lookup benchmark
+            benchmarkBatchLookup(tree, trie, store);
+            break;
+
+        case 12: // Multi-threaded query throughput benchmark
+            benchmarkQueryThroughput(tree, trie, frozenTrie, store);
+            break;
+
+        case 13: // Concurrent reads during updates
+            benchmarkConcurrentUpdates(DICTIONARY_FILENAME);
+            break;
+
+        case 14: // Static ordered index vs BST
+            benchmarkOrderedIndex(tree, sortedIndex, store);
+            break;
+
+        case 15: // Deep structures on a small stack
+            stressTestDeepStructures(STRESS_SNAPSHOT_FILENAME);
+            break;
+
+        case 16: // Heap allocations per lookup
+            benchmarkLookupAllocations(tree, trie, frozenTrie, hashIndex, store);
             break;
 
         case 0: // Exit program
@@ -12,4 +12,36 @@ using namespace std;
  */
 static constexpr const char *DICTIONARY_FILENAME = "dictionary.txt";
 
+/**
+ * SNAPSHOT_FILENAME - Binary snapshot of the loaded structures
+ * Written after a load from DICTIONARY_FILENAME and memory-mapped on later starts;
+ * rebuilt automatically when it is missing, stale or from another build
+ */
+static constexpr const char *SNAPSHOT_FILENAME = "dictionary.snap";
+
+/**
+ * WEIGHTS_FILENAME - Optional popularity weights for autocomplete ranking
+ * Lines are "Word|Count" or bare logged queries; without it every weight is 0
+ */
+static constexpr const char *WEIGHTS_FILENAME = "weights.txt";
+
+/**
+ * PATTERN_NODE_BUDGET - Trie nodes a single wildcard query may visit
+ * Each node is visited at most once per query; this allows a full walk of the
+ * bundled dictionary's Trie (about 607,000 nodes) but bounds larger ones
+ */
+static constexpr long long PATTERN_NODE_BUDGET = 1000000;
+
+/**
+ * BENCHMARK_FILENAME - JSON results of the performance comparison
+ * Rewritten by every run so that runs can be diffed
+ */
+static constexpr const char *BENCHMARK_FILENAME = "benchmark.json";
+
+/**
+ * STRESS_SNAPSHOT_FILENAME - Scratch snapshot of the deep-structure stress test
+ * Holds a 10M-node degenerate tree while it is loaded, then is removed
+ */
+static constexpr const char *STRESS_SNAPSHOT_FILENAME = "stress.snap";
+
 #endif // MAIN_H